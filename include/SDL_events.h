@@ -1083,6 +1083,65 @@ extern DECLSPEC Uint8 SDLCALL SDL_EventState(Uint32 type, int state);
  */
 extern DECLSPEC Uint32 SDLCALL SDL_RegisterEvents(int numevents);
 
+/**
+ * The maximum number of touch fingers reported in an SDL_InputSnapshot.
+ */
+#define SDL_INPUT_SNAPSHOT_MAX_FINGERS 16
+
+/**
+ * A finger that is touching a touch device, as seen in an SDL_InputSnapshot.
+ */
+typedef struct SDL_InputSnapshotFinger
+{
+    SDL_TouchID touchId;    /**< The touch device id */
+    SDL_FingerID fingerId;
+    float x;                /**< Normalized in the range 0...1 */
+    float y;                /**< Normalized in the range 0...1 */
+    float pressure;         /**< Normalized in the range 0...1 */
+} SDL_InputSnapshotFinger;
+
+/**
+ * A consistent copy of the keyboard, mouse and touch state.
+ *
+ * \sa SDL_GetInputSnapshot
+ */
+typedef struct SDL_InputSnapshot
+{
+    Uint32 version;         /**< Increases every time the input state changes */
+    Uint16 mod;             /**< The current key modifiers, see ::SDL_Keymod */
+    Uint8 keys[SDL_NUM_SCANCODES];  /**< 1 for each key that is pressed, indexed by ::SDL_Scancode */
+    Uint32 mouseWindowID;   /**< The window with mouse focus, or 0 */
+    Sint32 mouseX;          /**< X coordinate of the mouse, relative to the focus window */
+    Sint32 mouseY;          /**< Y coordinate of the mouse, relative to the focus window */
+    Uint32 mouseButtons;    /**< The mouse button state, see SDL_BUTTON() */
+    int numFingers;         /**< The number of valid entries in fingers */
+    SDL_InputSnapshotFinger fingers[SDL_INPUT_SNAPSHOT_MAX_FINGERS];
+} SDL_InputSnapshot;
+
+/**
+ * Get a consistent copy of the keyboard, mouse and touch state.
+ *
+ * The state is the same that SDL_GetKeyboardState(), SDL_GetModState(),
+ * SDL_GetMouseState() and SDL_GetTouchFinger() report, and is updated as
+ * SDL_PumpEvents() processes input. Unlike those functions, this one may be
+ * called from any thread at any time. It never waits for the event loop, and
+ * never returns a state that is partway through an update.
+ *
+ * Compare the version of two snapshots to see whether the input state
+ * changed in between.
+ *
+ * \param snapshot the structure filled in with the current input state
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.0.16.
+ *
+ * \sa SDL_GetKeyboardState
+ * \sa SDL_GetMouseState
+ * \sa SDL_PumpEvents
+ */
+extern DECLSPEC int SDLCALL SDL_GetInputSnapshot(SDL_InputSnapshot *snapshot);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -764,6 +764,46 @@ extern DECLSPEC SDL_bool SDLCALL SDL_GameControllerIsSensorEnabled(SDL_GameContr
  */
 extern DECLSPEC int SDLCALL SDL_GameControllerGetSensorData(SDL_GameController *gamecontroller, SDL_SensorType type, float *data, int num_values);
 
+/**
+ * A single timestamped reading from a game controller sensor.
+ *
+ * The timestamp is taken when SDL processes the reading, during
+ * SDL_GameControllerUpdate() or event pumping, not when the device sent it.
+ * Samples processed in the same update may have nearly the same timestamp.
+ *
+ * \sa SDL_GameControllerGetSensorDataBatch
+ */
+typedef struct SDL_GameControllerSensorSample
+{
+    Uint64 timestamp;   /**< The value of SDL_GetPerformanceCounter() when SDL processed the sample */
+    float data[3];      /**< Up to 3 values from the sensor, unused values are 0 */
+} SDL_GameControllerSensorSample;
+
+/**
+ * Get every sample reported by a game controller sensor since the last call.
+ *
+ * SDL_GameControllerGetSensorData() only returns the latest reading, which
+ * loses samples when the sensor reports faster than the application polls.
+ * The first call to this function starts queueing samples for the sensor;
+ * later calls remove up to `max_samples` of the queued samples, oldest first.
+ * If the application falls far behind, the oldest samples are dropped.
+ *
+ * Applications that only use this function can turn off the per-sample
+ * events with SDL_EventState(SDL_CONTROLLERSENSORUPDATE, SDL_IGNORE).
+ *
+ * \param gamecontroller The controller to query
+ * \param type The type of sensor to query
+ * \param samples An array filled with the queued samples
+ * \param max_samples The number of elements in the samples array
+ * \returns the number of samples written, or -1 if an error occurred.
+ *
+ * \since This function is available since SDL 2.0.16.
+ *
+ * \sa SDL_GameControllerGetSensorData
+ * \sa SDL_GameControllerSetSensorEnabled
+ */
+extern DECLSPEC int SDLCALL SDL_GameControllerGetSensorDataBatch(SDL_GameController *gamecontroller, SDL_SensorType type, SDL_GameControllerSensorSample *samples, int max_samples);
+
 /**
  * Start a rumble effect on a game controller.
  *
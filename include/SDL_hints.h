@@ -785,12 +785,19 @@ extern "C" {
 
  /**
   *  \brief  A variable controlling whether a separate thread should be used
-  *          for handling joystick detection and raw input messages on Windows
+  *          for handling joystick detection and raw input messages on Windows,
+  *          or for reading joystick input on Linux
   *
   *  This variable can be set to the following values:
   *    "0"       - A separate thread is not used (the default)
   *    "1"       - A separate thread is used for handling raw input messages
   *
+  *  On Linux the thread waits on all open evdev joysticks and reads their
+  *  input as it arrives. SDL_JoystickGetAxis(), SDL_JoystickGetButton() and
+  *  SDL_JoystickGetHat() return the latest complete report right away, while
+  *  the events are still sent by SDL_JoystickUpdate().
+  *
+  *  This hint should be set before the joystick subsystem is initialized.
   */
 #define SDL_HINT_JOYSTICK_THREAD "SDL_JOYSTICK_THREAD"
 
@@ -1682,6 +1689,46 @@ extern "C" {
  */
 #define SDL_HINT_X11_FORCE_OVERRIDE_REDIRECT "SDL_X11_FORCE_OVERRIDE_REDIRECT"
 
+/**
+ *  \brief  A variable controlling the number of threads used for SDL_RWreadAsync()
+ *
+ *  This variable is read when the first background read is queued, and
+ *  can be set to a number of threads. The default is 4.
+ */
+#define SDL_HINT_ASYNCIO_THREADS "SDL_ASYNCIO_THREADS"
+
+/**
+ *  \brief  A variable controlling the number of threads used to convert large images
+ *
+ *  This variable can be set to the following values:
+ *    "1"       - Convert on the calling thread (default)
+ *    "0"       - Use one thread per CPU core
+ *    "N"       - Split large conversions into up to N bands of rows
+ *
+ *  This is used by SDL_ConvertPixels(), SDL_ConvertSurface() and other
+ *  unscaled software blits. Small images are always converted on the
+ *  calling thread.
+ */
+#define SDL_HINT_PIXEL_CONVERSION_THREADS "SDL_PIXEL_CONVERSION_THREADS"
+
+/**
+ *  \brief  A variable controlling whether the X11 window framebuffer uses shared memory
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Always send the framebuffer to the X server with XPutImage
+ *    "1"       - Require the MIT-SHM extension, creating the framebuffer fails without it
+ *
+ *  By default SDL uses MIT-SHM when the X server supports it and quietly
+ *  falls back to XPutImage otherwise. The path that was picked, and the
+ *  number of bytes each update sends, is logged to SDL_LOG_CATEGORY_VIDEO
+ *  at the debug and verbose priorities.
+ *
+ *  While a window has a framebuffer, SDL_GetWindowData(window, "SDL_X11_FRAMEBUFFER_BYTES")
+ *  returns a pointer to a Uint64 with the total number of bytes its
+ *  updates have sent to the X server.
+ */
+#define SDL_HINT_VIDEO_X11_FRAMEBUFFER_SHM "SDL_VIDEO_X11_FRAMEBUFFER_SHM"
+
 /**
  *  \brief  An enumeration of hint priorities
  */
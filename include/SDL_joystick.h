@@ -718,6 +718,26 @@ extern DECLSPEC int SDLCALL SDL_JoystickGetBall(SDL_Joystick *joystick,
 extern DECLSPEC Uint8 SDLCALL SDL_JoystickGetButton(SDL_Joystick *joystick,
                                                     int button);
 
+/**
+ * Get the time the state of a joystick was read from the device.
+ *
+ * This is when the axes, buttons and hats returned by SDL_JoystickGetAxis(),
+ * SDL_JoystickGetButton() and SDL_JoystickGetHat() last changed. Input is
+ * usually read by SDL_JoystickUpdate(), but with SDL_HINT_JOYSTICK_THREAD on
+ * Linux it is read as it arrives, and these functions return the latest
+ * complete report of the device.
+ *
+ * \param joystick an SDL_Joystick structure containing joystick information
+ * \returns the value of SDL_GetPerformanceCounter() at that time, or 0 if
+ *          the state hasn't changed since the joystick was opened.
+ *
+ * \since This function is available since SDL 2.0.16.
+ *
+ * \sa SDL_GetPerformanceCounter
+ * \sa SDL_JoystickGetAxis
+ */
+extern DECLSPEC Uint64 SDLCALL SDL_JoystickGetStateTimestamp(SDL_Joystick *joystick);
+
 /**
  * Start a rumble effect.
  *
@@ -171,6 +171,58 @@ extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromMem(void *mem, int size);
 extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromConstMem(const void *mem,
                                                       int size);
 
+/**
+ * Open a file for reading by mapping it into memory.
+ *
+ * The returned stream is read-only and reads are plain memory copies out of
+ * the mapping. Its type is `SDL_RWOPS_MEMORY_RO`, so the whole file can be
+ * accessed directly through `hidden.mem.base` (up to `hidden.mem.stop`)
+ * without copying, for as long as the stream is open.
+ *
+ * If the file can't be mapped (the platform has no support for it, the file
+ * is empty or isn't a regular file), this falls back to SDL_RWFromFile() in
+ * "rb" mode, so check the stream type before touching `hidden.mem`.
+ *
+ * \param file a UTF-8 string representing the filename to open
+ * \returns a pointer to the SDL_RWops structure that is created, or NULL on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.0.16.
+ *
+ * \sa SDL_RWclose
+ * \sa SDL_RWFromFile
+ * \sa SDL_LoadFile_RW
+ */
+extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromFileMapped(const char *file);
+
+/**
+ * Wrap another data stream with a read-ahead and write-behind buffer.
+ *
+ * Reads are served from a buffer that is refilled from `inner` in blocks of
+ * `bufsize` bytes, and writes are collected until the buffer fills, the
+ * stream is seeked or it is closed. This makes many small reads and writes,
+ * like the ones done by SDL_ReadLE32() and friends, much cheaper on streams
+ * where every call goes to the operating system. The endian read functions
+ * take their values directly from the buffer when they can.
+ *
+ * The buffered stream takes ownership of `inner`: closing it flushes any
+ * pending writes and closes `inner` too. `inner` should not be used directly
+ * while the buffered stream is open.
+ *
+ * \param inner the SDL_RWops to buffer
+ * \param bufsize the size of the buffer in bytes, or 0 for a default size
+ * \returns a pointer to the SDL_RWops structure that is created, or NULL on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.0.16.
+ *
+ * \sa SDL_RWclose
+ * \sa SDL_RWread
+ * \sa SDL_RWwrite
+ * \sa SDL_ReadLE32
+ */
+extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromBuffered(SDL_RWops *inner, size_t bufsize);
+
 /* @} *//* RWFrom functions */
 
 
@@ -371,6 +423,74 @@ extern DECLSPEC void *SDLCALL SDL_LoadFile_RW(SDL_RWops *src,
  */
 extern DECLSPEC void *SDLCALL SDL_LoadFile(const char *file, size_t *datasize);
 
+/**
+ * An opaque handle for a read running in the background.
+ *
+ * \sa SDL_RWreadAsync
+ */
+typedef struct SDL_AsyncIOTask SDL_AsyncIOTask;
+
+/**
+ * Read from a data stream in the background.
+ *
+ * This queues a read of up to `size` bytes at `offset` into `ptr` and returns
+ * immediately. The read is done by a pool of I/O threads; the number of
+ * threads can be set with the SDL_HINT_ASYNCIO_THREADS hint before the first
+ * call. Requests on the same stream are always done one after another, in
+ * the order they were submitted, while requests on different streams may run
+ * in parallel.
+ *
+ * The stream and the buffer must stay valid and must not be used by the
+ * application until the read has finished. Every task returned by this
+ * function must be passed to SDL_WaitAsyncIOTask() exactly once.
+ *
+ * \param context the SDL_RWops to read from
+ * \param offset the position in the stream to read from, or -1 to read from
+ *               the position left by the previous request
+ * \param ptr a pointer to a buffer of at least `size` bytes
+ * \param size the number of bytes to read
+ * \returns a task handle, or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 2.0.16.
+ *
+ * \sa SDL_AsyncIOTaskDone
+ * \sa SDL_WaitAsyncIOTask
+ */
+extern DECLSPEC SDL_AsyncIOTask *SDLCALL SDL_RWreadAsync(SDL_RWops *context,
+                                                         Sint64 offset,
+                                                         void *ptr,
+                                                         size_t size);
+
+/**
+ * Check whether a background read has finished, without blocking.
+ *
+ * \param task the task returned by SDL_RWreadAsync()
+ * \returns SDL_TRUE if the read has finished and SDL_WaitAsyncIOTask() will
+ *          return immediately, SDL_FALSE otherwise.
+ *
+ * \since This function is available since SDL 2.0.16.
+ *
+ * \sa SDL_RWreadAsync
+ * \sa SDL_WaitAsyncIOTask
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_AsyncIOTaskDone(SDL_AsyncIOTask *task);
+
+/**
+ * Wait for a background read to finish and free the task.
+ *
+ * \param task the task returned by SDL_RWreadAsync()
+ * \returns the number of bytes read, which is less than the requested size
+ *          at the end of the stream, or -1 on error; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 2.0.16.
+ *
+ * \sa SDL_AsyncIOTaskDone
+ * \sa SDL_RWreadAsync
+ */
+extern DECLSPEC Sint64 SDLCALL SDL_WaitAsyncIOTask(SDL_AsyncIOTask *task);
+
 /**
  *  \name Read endian functions
  *
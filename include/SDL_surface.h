@@ -657,6 +657,36 @@ extern DECLSPEC int SDLCALL SDL_ConvertPixels(int width, int height,
                                               Uint32 dst_format,
                                               void * dst, int dst_pitch);
 
+/**
+ * Premultiply the alpha on a block of pixels.
+ *
+ * This converts the pixels to `dst_format` like SDL_ConvertPixels() and
+ * multiplies the color channels by the alpha channel, so they can be blitted
+ * or rendered with SDL_BLENDMODE_BLEND_PREMULTIPLIED. The source and
+ * destination may be the same block of pixels if the formats are the same.
+ *
+ * \param width the width of the block to convert, in pixels
+ * \param height the height of the block to convert, in pixels
+ * \param src_format an SDL_PixelFormatEnum value of the `src` pixels format
+ * \param src a pointer to the source pixels
+ * \param src_pitch the pitch of the source pixels, in bytes
+ * \param dst_format an SDL_PixelFormatEnum value of the `dst` pixels format
+ * \param dst a pointer to be filled in with premultiplied pixel data
+ * \param dst_pitch the pitch of the destination pixels, in bytes
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 2.0.16.
+ *
+ * \sa SDL_ConvertPixels
+ * \sa SDL_SetSurfaceBlendMode
+ */
+extern DECLSPEC int SDLCALL SDL_PremultiplyAlpha(int width, int height,
+                                                 Uint32 src_format,
+                                                 const void * src, int src_pitch,
+                                                 Uint32 dst_format,
+                                                 void * dst, int dst_pitch);
+
 /**
  * Perform a fast fill of a rectangle with a specific color.
  *
@@ -48,6 +48,7 @@
 #include "SDL_revision.h"
 #include "SDL_assert_c.h"
 #include "events/SDL_events_c.h"
+#include "file/SDL_asyncio_c.h"
 #include "haptic/SDL_haptic_c.h"
 #include "joystick/SDL_joystick_c.h"
 #include "sensor/SDL_sensor_c.h"
@@ -441,6 +442,8 @@ SDL_Quit(void)
 #endif
     SDL_QuitSubSystem(SDL_INIT_EVERYTHING);
 
+    SDL_QuitAsyncIO();
+
 #if !SDL_TIMERS_DISABLED
     SDL_TicksQuit();
 #endif
@@ -116,6 +116,35 @@
 #define SDL_HAVE_YUV                    !SDL_LEAN_AND_MEAN
 #endif
 
+/* Compiler support for SIMD code paths that are chosen at runtime, e.g.
+   with SDL_HasSSE41() or SDL_HasAVX2(), without building all of SDL for
+   that instruction set. Functions using these intrinsics must be marked
+   with SDL_TARGETING(). */
+#if defined(__clang__) && defined(__has_attribute)
+# if __has_attribute(target)
+#  define SDL_HAS_TARGET_ATTRIBS
+# endif
+#elif defined(__GNUC__) && (__GNUC__ + (__GNUC_MINOR__ >= 9) > 4) /* gcc >= 4.9 */
+# define SDL_HAS_TARGET_ATTRIBS
+#endif
+
+#ifdef SDL_HAS_TARGET_ATTRIBS
+# define SDL_TARGETING(x) __attribute__((target(x)))
+#else
+# define SDL_TARGETING(x)
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+# if defined(__SSE4_1__) || (defined(_MSC_VER) && (_MSC_VER >= 1500)) || \
+     (defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H) && defined(SDL_HAS_TARGET_ATTRIBS))
+#  define SDL_SSE4_1_INTRINSICS 1
+# endif
+# if defined(__AVX2__) || (defined(_MSC_VER) && (_MSC_VER >= 1700)) || \
+     (defined(HAVE_IMMINTRIN_H) && !defined(SDL_DISABLE_IMMINTRIN_H) && defined(SDL_HAS_TARGET_ATTRIBS))
+#  define SDL_AVX2_INTRINSICS 1
+# endif
+#endif
+
 #include "SDL_assert.h"
 #include "SDL_log.h"
 
@@ -36,6 +36,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/epoll.h>
 #include <linux/input.h>
 
 #include "SDL.h"
@@ -62,6 +63,15 @@ typedef struct SDL_evdevlist_item
 {
     char *path;
     int fd;
+    SDL_bool ready;
+
+    /* Mouse movement since the last SYN_REPORT, sent as one event per frame */
+    struct {
+        int rel_x, rel_y;
+        int abs_x, abs_y;
+        SDL_bool has_abs_x, has_abs_y;
+        int wheel_x, wheel_y;
+    } mouse_frame;
 
     /* TODO: use this for every device, not just touchscreen */
     int out_of_sync;
@@ -102,6 +112,7 @@ typedef struct SDL_EVDEV_PrivateData
     SDL_evdevlist_item *first;
     SDL_evdevlist_item *last;
     SDL_EVDEV_keyboard_state *kbd;
+    int epoll_fd;
 } SDL_EVDEV_PrivateData;
 
 #undef _THIS
@@ -146,8 +157,14 @@ SDL_EVDEV_Init(void)
             return SDL_OutOfMemory();
         }
 
+        /* If this fails we just read every device each time we poll */
+        _this->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
 #if SDL_USE_LIBUDEV
         if (SDL_UDEV_Init() < 0) {
+            if (_this->epoll_fd >= 0) {
+                close(_this->epoll_fd);
+            }
             SDL_free(_this);
             _this = NULL;
             return -1;
@@ -156,6 +173,9 @@ SDL_EVDEV_Init(void)
         /* Set up the udev callback */
         if (SDL_UDEV_AddCallback(SDL_EVDEV_udev_callback) < 0) {
             SDL_UDEV_Quit();
+            if (_this->epoll_fd >= 0) {
+                close(_this->epoll_fd);
+            }
             SDL_free(_this);
             _this = NULL;
             return -1;
@@ -203,6 +223,9 @@ SDL_EVDEV_Quit(void)
         SDL_assert(_this->last == NULL);
         SDL_assert(_this->num_devices == 0);
 
+        if (_this->epoll_fd >= 0) {
+            close(_this->epoll_fd);
+        }
         SDL_free(_this);
         _this = NULL;
     }
@@ -236,11 +259,30 @@ static void SDL_EVDEV_udev_callback(SDL_UDEV_deviceevent udev_event, int udev_cl
 }
 #endif /* SDL_USE_LIBUDEV */
 
+static void
+SDL_EVDEV_flush_mouse_frame(SDL_evdevlist_item *item, SDL_Mouse *mouse)
+{
+    if (item->mouse_frame.rel_x || item->mouse_frame.rel_y) {
+        SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_TRUE, item->mouse_frame.rel_x, item->mouse_frame.rel_y);
+    }
+    if (item->mouse_frame.has_abs_x || item->mouse_frame.has_abs_y) {
+        SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_FALSE,
+                            item->mouse_frame.has_abs_x ? item->mouse_frame.abs_x : mouse->x,
+                            item->mouse_frame.has_abs_y ? item->mouse_frame.abs_y : mouse->y);
+    }
+    if (item->mouse_frame.wheel_x || item->mouse_frame.wheel_y) {
+        SDL_SendMouseWheel(mouse->focus, mouse->mouseID, (float)item->mouse_frame.wheel_x, (float)item->mouse_frame.wheel_y, SDL_MOUSEWHEEL_NORMAL);
+    }
+    SDL_zero(item->mouse_frame);
+}
+
 void 
 SDL_EVDEV_Poll(void)
 {
     struct input_event events[32];
+    struct epoll_event ready[16];
     int i, j, len;
+    SDL_bool poll_all = SDL_TRUE;
     SDL_evdevlist_item *item;
     SDL_Scancode scan_code;
     int mouse_button;
@@ -257,7 +299,25 @@ SDL_EVDEV_Poll(void)
 
     mouse = SDL_GetMouse();
 
+    /* Only read the devices that have input waiting, unless there are more
+       of them than fit in one call, in which case we just read them all */
+    if (_this->epoll_fd >= 0) {
+        len = epoll_wait(_this->epoll_fd, ready, SDL_arraysize(ready), 0);
+        if (len >= 0 && len < (int)SDL_arraysize(ready)) {
+            for (i = 0; i < len; ++i) {
+                item = (SDL_evdevlist_item *)ready[i].data.ptr;
+                item->ready = SDL_TRUE;
+            }
+            poll_all = SDL_FALSE;
+        }
+    }
+
     for (item = _this->first; item != NULL; item = item->next) {
+        if (!poll_all && !item->ready) {
+            continue;
+        }
+        item->ready = SDL_FALSE;
+
         while ((len = read(item->fd, events, (sizeof events))) > 0) {
             len /= sizeof(events[0]);
             for (i = 0; i < len; ++i) {
@@ -272,6 +332,10 @@ SDL_EVDEV_Poll(void)
                 case EV_KEY:
                     if (events[i].code >= BTN_MOUSE && events[i].code < BTN_MOUSE + SDL_arraysize(EVDEV_MouseButtons)) {
                         mouse_button = events[i].code - BTN_MOUSE;
+
+                        /* Make sure the click happens where the mouse moved to in this frame */
+                        SDL_EVDEV_flush_mouse_frame(item, mouse);
+
                         if (events[i].value == 0) {
                             SDL_SendMouseButton(mouse->focus, mouse->mouseID, SDL_RELEASED, EVDEV_MouseButtons[mouse_button]);
                         } else if (events[i].value == 1) {
@@ -351,16 +415,20 @@ SDL_EVDEV_Poll(void)
                             if (item->touchscreen_data->max_slots != 1)
                                 break;
                             item->touchscreen_data->slots[0].x = events[i].value;
-                        } else
-                            SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_FALSE, events[i].value, mouse->y);
+                        } else {
+                            item->mouse_frame.abs_x = events[i].value;
+                            item->mouse_frame.has_abs_x = SDL_TRUE;
+                        }
                         break;
                     case ABS_Y:
                         if (item->is_touchscreen) {
                             if (item->touchscreen_data->max_slots != 1)
                                 break;
                             item->touchscreen_data->slots[0].y = events[i].value;
-                        } else
-                            SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_FALSE, mouse->x, events[i].value);
+                        } else {
+                            item->mouse_frame.abs_y = events[i].value;
+                            item->mouse_frame.has_abs_y = SDL_TRUE;
+                        }
                         break;
                     default:
                         break;
@@ -369,16 +437,16 @@ SDL_EVDEV_Poll(void)
                 case EV_REL:
                     switch(events[i].code) {
                     case REL_X:
-                        SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_TRUE, events[i].value, 0);
+                        item->mouse_frame.rel_x += events[i].value;
                         break;
                     case REL_Y:
-                        SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_TRUE, 0, events[i].value);
+                        item->mouse_frame.rel_y += events[i].value;
                         break;
                     case REL_WHEEL:
-                        SDL_SendMouseWheel(mouse->focus, mouse->mouseID, 0, events[i].value, SDL_MOUSEWHEEL_NORMAL);
+                        item->mouse_frame.wheel_y += events[i].value;
                         break;
                     case REL_HWHEEL:
-                        SDL_SendMouseWheel(mouse->focus, mouse->mouseID, events[i].value, 0, SDL_MOUSEWHEEL_NORMAL);
+                        item->mouse_frame.wheel_x += events[i].value;
                         break;
                     default:
                         break;
@@ -387,6 +455,8 @@ SDL_EVDEV_Poll(void)
                 case EV_SYN:
                     switch (events[i].code) {
                     case SYN_REPORT:
+                        SDL_EVDEV_flush_mouse_frame(item, mouse);
+
                         if (!item->is_touchscreen) /* FIXME: temp hack */
                             break;
 
@@ -430,6 +500,8 @@ SDL_EVDEV_Poll(void)
                             item->out_of_sync = 0;
                         break;
                     case SYN_DROPPED:
+                        /* The rest of this frame is incomplete, drop it */
+                        SDL_zero(item->mouse_frame);
                         if (item->is_touchscreen)
                             item->out_of_sync = 1;
                         SDL_EVDEV_sync_device(item);
@@ -755,6 +827,19 @@ SDL_EVDEV_device_added(const char *dev_path, int udev_class)
         _this->last = item;
     }
 
+    if (_this->epoll_fd >= 0) {
+        struct epoll_event event;
+
+        SDL_zero(event);
+        event.events = EPOLLIN;
+        event.data.ptr = item;
+        if (epoll_ctl(_this->epoll_fd, EPOLL_CTL_ADD, item->fd, &event) < 0) {
+            /* Go back to reading every device each time we poll */
+            close(_this->epoll_fd);
+            _this->epoll_fd = -1;
+        }
+    }
+
     SDL_EVDEV_sync_device(item);
 
     return _this->num_devices++;
@@ -782,6 +867,9 @@ SDL_EVDEV_device_removed(const char *dev_path)
             if (item->is_touchscreen) {
                 SDL_EVDEV_destroy_touchscreen(item);
             }
+            if (_this->epoll_fd >= 0) {
+                epoll_ctl(_this->epoll_fd, EPOLL_CTL_DEL, item->fd, NULL);
+            }
             close(item->fd);
             SDL_free(item->path);
             SDL_free(item);
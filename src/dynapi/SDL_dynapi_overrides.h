@@ -814,3 +814,12 @@
 #define SDL_FlashWindow SDL_FlashWindow_REAL
 #define SDL_GameControllerSendEffect SDL_GameControllerSendEffect_REAL
 #define SDL_JoystickSendEffect SDL_JoystickSendEffect_REAL
+#define SDL_RWFromFileMapped SDL_RWFromFileMapped_REAL
+#define SDL_RWFromBuffered SDL_RWFromBuffered_REAL
+#define SDL_RWreadAsync SDL_RWreadAsync_REAL
+#define SDL_AsyncIOTaskDone SDL_AsyncIOTaskDone_REAL
+#define SDL_WaitAsyncIOTask SDL_WaitAsyncIOTask_REAL
+#define SDL_PremultiplyAlpha SDL_PremultiplyAlpha_REAL
+#define SDL_GameControllerGetSensorDataBatch SDL_GameControllerGetSensorDataBatch_REAL
+#define SDL_GetInputSnapshot SDL_GetInputSnapshot_REAL
+#define SDL_JoystickGetStateTimestamp SDL_JoystickGetStateTimestamp_REAL
@@ -879,3 +879,12 @@ SDL_DYNAPI_PROC(void,SDL_SetWindowAlwaysOnTop,(SDL_Window *a, SDL_bool b),(a,b),
 SDL_DYNAPI_PROC(int,SDL_FlashWindow,(SDL_Window *a, Uint32 b),(a, b),return)
 SDL_DYNAPI_PROC(int,SDL_GameControllerSendEffect,(SDL_GameController *a, const void *b, int c),(a,b,c),return)
 SDL_DYNAPI_PROC(int,SDL_JoystickSendEffect,(SDL_Joystick *a, const void *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_RWops*,SDL_RWFromFileMapped,(const char *a),(a),return)
+SDL_DYNAPI_PROC(SDL_RWops*,SDL_RWFromBuffered,(SDL_RWops *a, size_t b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AsyncIOTask*,SDL_RWreadAsync,(SDL_RWops *a, Sint64 b, void *c, size_t d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_AsyncIOTaskDone,(SDL_AsyncIOTask *a),(a),return)
+SDL_DYNAPI_PROC(Sint64,SDL_WaitAsyncIOTask,(SDL_AsyncIOTask *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_PremultiplyAlpha,(int a, int b, Uint32 c, const void *d, int e, Uint32 f, void *g, int h),(a,b,c,d,e,f,g,h),return)
+SDL_DYNAPI_PROC(int,SDL_GameControllerGetSensorDataBatch,(SDL_GameController *a, SDL_SensorType b, SDL_GameControllerSensorSample *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_GetInputSnapshot,(SDL_InputSnapshot *a),(a),return)
+SDL_DYNAPI_PROC(Uint64,SDL_JoystickGetStateTimestamp,(SDL_Joystick *a),(a),return)
@@ -1192,6 +1192,58 @@ SDL_SendLocaleChangedEvent(void)
     return SDL_SendAppEvent(SDL_LOCALECHANGED);
 }
 
+/* The input snapshot is protected by a sequence lock: writers make the
+   sequence number odd while they update it, and readers retry their copy
+   if the sequence number was odd or changed while they were copying.
+ */
+static SDL_InputSnapshot SDL_input_snapshot;
+static SDL_atomic_t SDL_input_snapshot_sequence;
+static SDL_SpinLock SDL_input_snapshot_lock;
+
+SDL_InputSnapshot *
+SDL_LockInputSnapshot(void)
+{
+    SDL_AtomicLock(&SDL_input_snapshot_lock);
+    SDL_AtomicIncRef(&SDL_input_snapshot_sequence);
+    SDL_MemoryBarrierRelease();
+    return &SDL_input_snapshot;
+}
+
+void
+SDL_UnlockInputSnapshot(void)
+{
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicIncRef(&SDL_input_snapshot_sequence);
+    SDL_AtomicUnlock(&SDL_input_snapshot_lock);
+}
+
+int
+SDL_GetInputSnapshot(SDL_InputSnapshot *snapshot)
+{
+    int sequence;
+
+    if (!snapshot) {
+        return SDL_InvalidParamError("snapshot");
+    }
+
+    for (;;) {
+        sequence = SDL_AtomicGet(&SDL_input_snapshot_sequence);
+        if (sequence & 1) {
+            /* An update is in progress, let the writer finish */
+            SDL_Delay(0);
+            continue;
+        }
+        SDL_MemoryBarrierAcquire();
+        SDL_memcpy(snapshot, &SDL_input_snapshot, sizeof(*snapshot));
+        SDL_MemoryBarrierAcquire();
+        if (SDL_AtomicGet(&SDL_input_snapshot_sequence) == sequence) {
+            break;
+        }
+    }
+    snapshot->version = (Uint32)sequence / 2;
+    return 0;
+}
+
 int
 SDL_EventsInit(void)
 {
@@ -50,6 +50,10 @@ extern int SDL_SendLocaleChangedEvent(void);
 
 extern int SDL_SendQuit(void);
 
+/* Update the state returned by SDL_GetInputSnapshot(), the version is set automatically */
+extern SDL_InputSnapshot *SDL_LockInputSnapshot(void);
+extern void SDL_UnlockInputSnapshot(void);
+
 extern int SDL_EventsInit(void);
 extern void SDL_EventsQuit(void);
 
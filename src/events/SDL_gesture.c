@@ -25,9 +25,14 @@
 
 #include "SDL_events.h"
 #include "SDL_endian.h"
+#include "SDL_cpuinfo.h"
 #include "SDL_events_c.h"
 #include "SDL_gesture_c.h"
 
+#ifdef __SSE__
+#define HAVE_SSE_INTRINSICS 1
+#endif
+
 /*
 #include <stdio.h>
 */
@@ -56,8 +61,15 @@ typedef struct {
     SDL_FloatPoint p[MAXPATHSIZE];
 } SDL_DollarPath;
 
+/* Templates keep their x and y coordinates in separate arrays, so we can
+   compare several points against a path at a time. The distance of each
+   point from the centroid doesn't change when the path is rotated, which
+   gives a cheap lower bound on how well a template can match a path.
+ */
 typedef struct {
-    SDL_FloatPoint path[DOLLARNPOINTS];
+    float x[DOLLARNPOINTS];
+    float y[DOLLARNPOINTS];
+    float radius[DOLLARNPOINTS];
     unsigned long hash;
 } SDL_DollarTemplate;
 
@@ -68,6 +80,7 @@ typedef struct {
     Uint16 numDownFingers;
 
     int numDollarTemplates;
+    int maxDollarTemplates;
     SDL_DollarTemplate *dollarTemplate;
 
     SDL_bool recording;
@@ -123,6 +136,9 @@ static unsigned long SDL_HashDollar(SDL_FloatPoint* points)
 
 static int SaveTemplate(SDL_DollarTemplate *templ, SDL_RWops *dst)
 {
+    SDL_FloatPoint path[DOLLARNPOINTS];
+    int i;
+
     if (dst == NULL) {
         return 0;
     }
@@ -130,27 +146,15 @@ static int SaveTemplate(SDL_DollarTemplate *templ, SDL_RWops *dst)
     /* No Longer storing the Hash, rehash on load */
     /* if (SDL_RWops.write(dst, &(templ->hash), sizeof(templ->hash), 1) != 1) return 0; */
 
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-    if (SDL_RWwrite(dst, templ->path,
-                    sizeof(templ->path[0]),DOLLARNPOINTS) != DOLLARNPOINTS) {
-        return 0;
+    for (i = 0; i < DOLLARNPOINTS; i++) {
+        path[i].x = SDL_SwapFloatLE(templ->x[i]);
+        path[i].y = SDL_SwapFloatLE(templ->y[i]);
     }
-#else
-    {
-        SDL_DollarTemplate copy = *templ;
-        SDL_FloatPoint *p = copy.path;
-        int i;
-        for (i = 0; i < DOLLARNPOINTS; i++, p++) {
-            p->x = SDL_SwapFloatLE(p->x);
-            p->y = SDL_SwapFloatLE(p->y);
-        }
 
-        if (SDL_RWwrite(dst, copy.path,
-                        sizeof(copy.path[0]),DOLLARNPOINTS) != DOLLARNPOINTS) {
-            return 0;
-        }
+    if (SDL_RWwrite(dst, path,
+                    sizeof(path[0]),DOLLARNPOINTS) != DOLLARNPOINTS) {
+        return 0;
     }
-#endif
 
     return 1;
 }
@@ -182,27 +186,49 @@ int SDL_SaveDollarTemplate(SDL_GestureID gestureId, SDL_RWops *dst)
     return SDL_SetError("Unknown gestureId");
 }
 
-/* path is an already sampled set of points
-Returns the index of the gesture on success, or -1 */
-static int SDL_AddDollarGesture_one(SDL_GestureTouch* inTouch, SDL_FloatPoint* path)
+/* Make room for at least count templates */
+static int SDL_ReserveDollarTemplates(SDL_GestureTouch* inTouch, int count)
 {
     SDL_DollarTemplate* dollarTemplate;
-    SDL_DollarTemplate *templ;
-    int index;
 
-    index = inTouch->numDollarTemplates;
+    if (count <= inTouch->maxDollarTemplates) {
+        return 0;
+    }
+
     dollarTemplate =
         (SDL_DollarTemplate *)SDL_realloc(inTouch->dollarTemplate,
-                                          (index + 1) *
+                                          count *
                                           sizeof(SDL_DollarTemplate));
     if (!dollarTemplate) {
         return SDL_OutOfMemory();
     }
     inTouch->dollarTemplate = dollarTemplate;
+    inTouch->maxDollarTemplates = count;
+    return 0;
+}
+
+/* path is an already sampled set of points
+Returns the index of the gesture on success, or -1 */
+static int SDL_AddDollarGesture_one(SDL_GestureTouch* inTouch, SDL_FloatPoint* path)
+{
+    SDL_DollarTemplate *templ;
+    int index;
+    int i;
+
+    index = inTouch->numDollarTemplates;
+    if (index == inTouch->maxDollarTemplates) {
+        if (SDL_ReserveDollarTemplates(inTouch, SDL_max(index * 2, 16)) < 0) {
+            return -1;
+        }
+    }
 
     templ = &inTouch->dollarTemplate[index];
-    SDL_memcpy(templ->path, path, DOLLARNPOINTS*sizeof(SDL_FloatPoint));
-    templ->hash = SDL_HashDollar(templ->path);
+    for (i = 0; i < DOLLARNPOINTS; i++) {
+        templ->x[i] = path[i].x;
+        templ->y[i] = path[i].y;
+        templ->radius[i] = SDL_sqrtf(path[i].x*path[i].x + path[i].y*path[i].y);
+    }
+    templ->hash = SDL_HashDollar(path);
     inTouch->numDollarTemplates++;
 
     return index;
@@ -242,10 +268,29 @@ int SDL_LoadDollarTemplates(SDL_TouchID touchId, SDL_RWops *src)
         }
     }
 
+    /* If we know how many templates there are, like when the templates
+       are loaded from a file opened with SDL_RWFromFileMapped(), make room
+       for all of them at once. Running out of memory here isn't an error,
+       we'll find out when adding the templates. */
+    {
+        const Sint64 size = SDL_RWsize(src);
+        const Sint64 offset = SDL_RWtell(src);
+        if (size > 0 && offset >= 0 && size > offset) {
+            const Sint64 count = (size - offset) / (DOLLARNPOINTS * sizeof(SDL_FloatPoint));
+            if (count > 0 && count < SDL_MAX_SINT32) {
+                for (i = 0; i < SDL_numGestureTouches; i++) {
+                    if (touchId < 0 || &SDL_gestureTouch[i] == touch) {
+                        SDL_ReserveDollarTemplates(&SDL_gestureTouch[i], SDL_gestureTouch[i].numDollarTemplates + (int)count);
+                    }
+                }
+            }
+        }
+    }
+
     while (1) {
-        SDL_DollarTemplate templ;
+        SDL_FloatPoint path[DOLLARNPOINTS];
 
-        if (SDL_RWread(src,templ.path,sizeof(templ.path[0]),DOLLARNPOINTS) < DOLLARNPOINTS) {
+        if (SDL_RWread(src,path,sizeof(path[0]),DOLLARNPOINTS) < DOLLARNPOINTS) {
             if (loaded == 0) {
                 return SDL_SetError("could not read any dollar gesture from rwops");
             }
@@ -254,7 +299,7 @@ int SDL_LoadDollarTemplates(SDL_TouchID touchId, SDL_RWops *src)
 
 #if SDL_BYTEORDER != SDL_LIL_ENDIAN
         for (i = 0; i < DOLLARNPOINTS; i++) {
-            SDL_FloatPoint *p = &templ.path[i];
+            SDL_FloatPoint *p = &path[i];
             p->x = SDL_SwapFloatLE(p->x);
             p->y = SDL_SwapFloatLE(p->y);
         }
@@ -262,7 +307,7 @@ int SDL_LoadDollarTemplates(SDL_TouchID touchId, SDL_RWops *src)
 
         if (touchId >= 0) {
             /* printf("Adding loaded gesture to 1 touch\n"); */
-            if (SDL_AddDollarGesture(touch, templ.path) >= 0)
+            if (SDL_AddDollarGesture(touch, path) >= 0)
                 loaded++;
         }
         else {
@@ -271,7 +316,7 @@ int SDL_LoadDollarTemplates(SDL_TouchID touchId, SDL_RWops *src)
                 touch = &SDL_gestureTouch[i];
                 /* printf("Adding loaded gesture to + touches\n"); */
                 /* TODO: What if this fails? */
-                SDL_AddDollarGesture(touch,templ.path);
+                SDL_AddDollarGesture(touch,path);
             }
             loaded++;
         }
@@ -282,23 +327,64 @@ int SDL_LoadDollarTemplates(SDL_TouchID touchId, SDL_RWops *src)
 
 
 #if defined(ENABLE_DOLLAR)
-static float dollarDifference(SDL_FloatPoint* points,SDL_FloatPoint* templ,float ang)
+/* Sum of the distances between the points of a path, rotated by the angle
+   with the given cosine and sine, and the points of a template */
+typedef float (*SDL_DollarDistanceFunc)(const SDL_DollarTemplate *points, const SDL_DollarTemplate *templ, float c, float s);
+static SDL_DollarDistanceFunc SDL_DollarDistance = NULL;
+
+static float dollarDistance_Scalar(const SDL_DollarTemplate *points, const SDL_DollarTemplate *templ, float c, float s)
 {
-    /*  SDL_FloatPoint p[DOLLARNPOINTS]; */
     float dist = 0;
-    SDL_FloatPoint p;
     int i;
     for (i = 0; i < DOLLARNPOINTS; i++) {
-        p.x = (float)(points[i].x * SDL_cos(ang) - points[i].y * SDL_sin(ang));
-        p.y = (float)(points[i].x * SDL_sin(ang) + points[i].y * SDL_cos(ang));
-        dist += (float)(SDL_sqrt((p.x-templ[i].x)*(p.x-templ[i].x)+
-                                 (p.y-templ[i].y)*(p.y-templ[i].y)));
+        const float dx = points->x[i] * c - points->y[i] * s - templ->x[i];
+        const float dy = points->x[i] * s + points->y[i] * c - templ->y[i];
+        dist += SDL_sqrtf(dx*dx + dy*dy);
     }
-    return dist/DOLLARNPOINTS;
+    return dist;
+}
+
+#if HAVE_SSE_INTRINSICS
+/* DOLLARNPOINTS is a multiple of 4, so there are no leftover points */
+static float dollarDistance_SSE(const SDL_DollarTemplate *points, const SDL_DollarTemplate *templ, float c, float s)
+{
+    const __m128 cos4 = _mm_set1_ps(c);
+    const __m128 sin4 = _mm_set1_ps(s);
+    __m128 sum = _mm_setzero_ps();
+    float result[4];
+    int i;
+
+    for (i = 0; i < DOLLARNPOINTS; i += 4) {
+        const __m128 px = _mm_loadu_ps(&points->x[i]);
+        const __m128 py = _mm_loadu_ps(&points->y[i]);
+        const __m128 dx = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(px, cos4), _mm_mul_ps(py, sin4)), _mm_loadu_ps(&templ->x[i]));
+        const __m128 dy = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(px, sin4), _mm_mul_ps(py, cos4)), _mm_loadu_ps(&templ->y[i]));
+        sum = _mm_add_ps(sum, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy))));
+    }
+    _mm_storeu_ps(result, sum);
+    return (result[0] + result[1]) + (result[2] + result[3]);
+}
+#endif
 
+static float dollarDifference(const SDL_DollarTemplate *points, const SDL_DollarTemplate *templ, float ang)
+{
+    return SDL_DollarDistance(points, templ, SDL_cosf(ang), SDL_sinf(ang)) / DOLLARNPOINTS;
 }
 
-static float bestDollarDifference(SDL_FloatPoint* points,SDL_FloatPoint* templ)
+/* Rotating a point doesn't change its distance from the centroid, so no
+   rotation of the path can get closer to the template than this */
+static float dollarLowerBound(const SDL_DollarTemplate *points, const SDL_DollarTemplate *templ)
+{
+    float bound = 0;
+    int i;
+    for (i = 0; i < DOLLARNPOINTS; i++) {
+        const float d = points->radius[i] - templ->radius[i];
+        bound += (d < 0) ? -d : d;
+    }
+    return bound/DOLLARNPOINTS;
+}
+
+static float bestDollarDifference(const SDL_DollarTemplate *points, const SDL_DollarTemplate *templ)
 {
     /*------------BEGIN DOLLAR BLACKBOX------------------
       -TRANSLATED DIRECTLY FROM PSUDEO-CODE AVAILABLE AT-
@@ -431,9 +517,27 @@ static int dollarNormalize(const SDL_DollarPath *path,SDL_FloatPoint *points, SD
     return numPoints;
 }
 
+typedef struct {
+    float bound;
+    int index;
+} SDL_DollarCandidate;
+
+static int SDLCALL dollarCompareCandidates(const void *a, const void *b)
+{
+    const SDL_DollarCandidate *A = (const SDL_DollarCandidate *)a;
+    const SDL_DollarCandidate *B = (const SDL_DollarCandidate *)b;
+    if (A->bound != B->bound) {
+        return (A->bound < B->bound) ? -1 : 1;
+    }
+    return A->index - B->index;
+}
+
 static float dollarRecognize(const SDL_DollarPath *path,int *bestTempl,SDL_GestureTouch* touch)
 {
     SDL_FloatPoint points[DOLLARNPOINTS];
+    SDL_DollarTemplate input;
+    SDL_DollarCandidate *candidates;
+    const int numTemplates = touch->numDollarTemplates;
     int i;
     float bestDiff = 10000;
 
@@ -443,10 +547,58 @@ static float dollarRecognize(const SDL_DollarPath *path,int *bestTempl,SDL_Gestu
 
     /* PrintPath(points); */
     *bestTempl = -1;
-    for (i = 0; i < touch->numDollarTemplates; i++) {
-        float diff = bestDollarDifference(points,touch->dollarTemplate[i].path);
-        if (diff < bestDiff) {bestDiff = diff; *bestTempl = i;}
+    if (numTemplates == 0) {
+        return bestDiff;
     }
+
+    if (!SDL_DollarDistance) {
+        SDL_DollarDistance = dollarDistance_Scalar;
+#if HAVE_SSE_INTRINSICS
+        if (SDL_HasSSE()) {
+            SDL_DollarDistance = dollarDistance_SSE;
+        }
+#endif
+    }
+
+    for (i = 0; i < DOLLARNPOINTS; i++) {
+        input.x[i] = points[i].x;
+        input.y[i] = points[i].y;
+        input.radius[i] = SDL_sqrtf(points[i].x*points[i].x + points[i].y*points[i].y);
+    }
+
+    /* Try the templates that could match best first, so we can stop as soon
+       as none of the rest can beat the best match so far. If we're out of
+       memory, just try them all in order. */
+    candidates = (SDL_DollarCandidate *)SDL_malloc(numTemplates * sizeof(*candidates));
+    if (candidates) {
+        for (i = 0; i < numTemplates; i++) {
+            candidates[i].bound = dollarLowerBound(&input, &touch->dollarTemplate[i]);
+            candidates[i].index = i;
+        }
+        SDL_qsort(candidates, numTemplates, sizeof(*candidates), dollarCompareCandidates);
+    }
+
+    for (i = 0; i < numTemplates; i++) {
+        const int index = candidates ? candidates[i].index : i;
+        const float bound = candidates ? candidates[i].bound : dollarLowerBound(&input, &touch->dollarTemplate[i]);
+        float diff;
+
+        if (bound > bestDiff) {
+            if (candidates) {
+                break;
+            }
+            continue;
+        }
+
+        /* Ties go to the earliest template, as if we had tried them in order */
+        diff = bestDollarDifference(&input, &touch->dollarTemplate[index]);
+        if (diff < bestDiff || (diff == bestDiff && index < *bestTempl)) {
+            bestDiff = diff;
+            *bestTempl = index;
+        }
+    }
+    SDL_free(candidates);
+
     return bestDiff;
 }
 #endif
@@ -51,6 +51,15 @@ struct SDL_Keyboard
 
 static SDL_Keyboard SDL_keyboard;
 
+static void
+SDL_UpdateKeyboardSnapshot(SDL_Keyboard *keyboard, SDL_Scancode scancode)
+{
+    SDL_InputSnapshot *snapshot = SDL_LockInputSnapshot();
+    snapshot->keys[scancode] = keyboard->keystate[scancode];
+    snapshot->mod = keyboard->modstate;
+    SDL_UnlockInputSnapshot();
+}
+
 static const SDL_Keycode SDL_default_keymap[SDL_NUM_SCANCODES] = {
     0, 0, 0, 0,
     'a',
@@ -774,6 +783,7 @@ SDL_SendKeyboardKeyInternal(Uint8 source, Uint8 state, SDL_Scancode scancode)
     } else {
         keyboard->modstate &= ~modifier;
     }
+    SDL_UpdateKeyboardSnapshot(keyboard, scancode);
 
     /* Post the event, if desired */
     posted = 0;
@@ -922,6 +932,7 @@ SDL_SetModState(SDL_Keymod modstate)
     SDL_Keyboard *keyboard = &SDL_keyboard;
 
     keyboard->modstate = modstate;
+    SDL_UpdateKeyboardSnapshot(keyboard, SDL_SCANCODE_UNKNOWN);
 }
 
 /* Note that SDL_ToggleModState() is not a public API. SDL_SetModState() is. */
@@ -934,6 +945,7 @@ SDL_ToggleModState(const SDL_Keymod modstate, const SDL_bool toggle)
     } else {
         keyboard->modstate &= ~modstate;
     }
+    SDL_UpdateKeyboardSnapshot(keyboard, SDL_SCANCODE_UNKNOWN);
 }
 
 
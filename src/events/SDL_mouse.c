@@ -177,6 +177,17 @@ SDL_GetMouse(void)
     return &SDL_mouse;
 }
 
+static void
+SDL_UpdateMouseSnapshot(SDL_Mouse *mouse)
+{
+    SDL_InputSnapshot *snapshot = SDL_LockInputSnapshot();
+    snapshot->mouseWindowID = mouse->focus ? mouse->focus->id : 0;
+    snapshot->mouseX = mouse->x;
+    snapshot->mouseY = mouse->y;
+    snapshot->mouseButtons = mouse->buttonstate;
+    SDL_UnlockInputSnapshot();
+}
+
 SDL_Window *
 SDL_GetMouseFocus(void)
 {
@@ -232,6 +243,7 @@ SDL_SetMouseFocus(SDL_Window * window)
 
     mouse->focus = window;
     mouse->has_position = SDL_FALSE;
+    SDL_UpdateMouseSnapshot(mouse);
 
     if (mouse->focus) {
         SDL_SendWindowEvent(mouse->focus, SDL_WINDOWEVENT_ENTER, 0, 0);
@@ -432,6 +444,7 @@ SDL_PrivateSendMouseMotion(SDL_Window * window, SDL_MouseID mouseID, int relativ
 
     mouse->xdelta += xrel;
     mouse->ydelta += yrel;
+    SDL_UpdateMouseSnapshot(mouse);
 
     /* Move the mouse cursor, if needed */
     if (mouse->cursor_shown && !mouse->relative_mode &&
@@ -540,6 +553,7 @@ SDL_PrivateSendMouseButton(SDL_Window * window, SDL_MouseID mouseID, Uint8 state
         return 0;
     }
     mouse->buttonstate = buttonstate;
+    SDL_UpdateMouseSnapshot(mouse);
 
     if (clicks < 0) {
         SDL_MouseClickState *clickstate = GetMouseClickState(mouse, button);
@@ -237,6 +237,30 @@ SDL_DelFinger(SDL_Touch* touch, SDL_FingerID fingerid)
     return 0;
 }
 
+static void
+SDL_UpdateTouchSnapshot(void)
+{
+    SDL_InputSnapshot *snapshot = SDL_LockInputSnapshot();
+    int i, j, count = 0;
+
+    for (i = 0; i < SDL_num_touch; ++i) {
+        const SDL_Touch *touch = SDL_touchDevices[i];
+
+        for (j = 0; j < touch->num_fingers && count < SDL_INPUT_SNAPSHOT_MAX_FINGERS; ++j) {
+            const SDL_Finger *finger = touch->fingers[j];
+            SDL_InputSnapshotFinger *snapshot_finger = &snapshot->fingers[count++];
+
+            snapshot_finger->touchId = touch->id;
+            snapshot_finger->fingerId = finger->id;
+            snapshot_finger->x = finger->x;
+            snapshot_finger->y = finger->y;
+            snapshot_finger->pressure = finger->pressure;
+        }
+    }
+    snapshot->numFingers = count;
+    SDL_UnlockInputSnapshot();
+}
+
 int
 SDL_SendTouch(SDL_TouchID id, SDL_FingerID fingerid, SDL_Window * window,
               SDL_bool down, float x, float y, float pressure)
@@ -309,6 +333,7 @@ SDL_SendTouch(SDL_TouchID id, SDL_FingerID fingerid, SDL_Window * window,
         if (SDL_AddFinger(touch, fingerid, x, y, pressure) < 0) {
             return 0;
         }
+        SDL_UpdateTouchSnapshot();
 
         posted = 0;
         if (SDL_GetEventState(SDL_FINGERDOWN) == SDL_ENABLE) {
@@ -347,6 +372,7 @@ SDL_SendTouch(SDL_TouchID id, SDL_FingerID fingerid, SDL_Window * window,
         }
 
         SDL_DelFinger(touch, fingerid);
+        SDL_UpdateTouchSnapshot();
     }
     return posted;
 }
@@ -417,6 +443,7 @@ SDL_SendTouchMotion(SDL_TouchID id, SDL_FingerID fingerid, SDL_Window * window,
     finger->x = x;
     finger->y = y;
     finger->pressure = pressure;
+    SDL_UpdateTouchSnapshot();
 
     /* Post the event, if desired */
     posted = 0;
@@ -455,6 +482,7 @@ SDL_DelTouch(SDL_TouchID id)
 
     SDL_num_touch--;
     SDL_touchDevices[index] = SDL_touchDevices[SDL_num_touch];
+    SDL_UpdateTouchSnapshot();
 
     /* Delete this touch device for gestures */
     SDL_GestureDelTouch(id);
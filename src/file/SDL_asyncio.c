@@ -0,0 +1,321 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* This file runs SDL_RWops reads on a small pool of worker threads.
+
+   Every stream is always serviced by the same worker, so requests on one
+   stream run in the order they were submitted and never race on the
+   stream's file position, while requests on different streams can
+   proceed in parallel.
+*/
+
+#include "SDL_atomic.h"
+#include "SDL_hints.h"
+#include "SDL_rwops.h"
+#include "SDL_thread.h"
+#include "SDL_asyncio_c.h"
+#include "../thread/SDL_systhread.h"
+
+#define DEFAULT_ASYNCIO_THREADS 4
+#define MAX_ASYNCIO_THREADS     64
+
+struct SDL_AsyncIOTask
+{
+    SDL_RWops *context;
+    Sint64 offset;
+    void *ptr;
+    size_t size;
+    Sint64 result;
+    char *error;
+    SDL_atomic_t done;
+    struct SDL_AsyncIOTask *next;
+};
+
+static void
+SDL_RunAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    size_t total = 0;
+
+    if (task->offset >= 0 && SDL_RWseek(task->context, task->offset, RW_SEEK_SET) < 0) {
+        task->result = -1;
+    } else {
+        while (total < task->size) {
+            size_t amount = SDL_RWread(task->context, (Uint8 *)task->ptr + total, 1, task->size - total);
+            if (amount == 0) {
+                break;
+            }
+            total += amount;
+        }
+        task->result = (Sint64)total;
+    }
+    if (task->result < 0) {
+        task->error = SDL_strdup(SDL_GetError());
+    }
+}
+
+#if !SDL_THREADS_DISABLED
+
+typedef struct
+{
+    SDL_Thread *thread;
+    SDL_cond *wakeup;
+    SDL_AsyncIOTask *head;
+    SDL_AsyncIOTask *tail;
+} SDL_AsyncIOWorker;
+
+static SDL_SpinLock SDL_asyncio_init_lock;
+static SDL_mutex *SDL_asyncio_lock;
+static SDL_cond *SDL_asyncio_done;
+static SDL_AsyncIOWorker *SDL_asyncio_workers;
+static int SDL_asyncio_num_workers;
+static SDL_bool SDL_asyncio_quit;
+
+static int SDLCALL
+SDL_AsyncIOThread(void *data)
+{
+    SDL_AsyncIOWorker *worker = (SDL_AsyncIOWorker *)data;
+
+    SDL_LockMutex(SDL_asyncio_lock);
+    for (;;) {
+        SDL_AsyncIOTask *task = worker->head;
+        if (!task) {
+            if (SDL_asyncio_quit) {
+                break;
+            }
+            SDL_CondWait(worker->wakeup, SDL_asyncio_lock);
+            continue;
+        }
+
+        worker->head = task->next;
+        if (!worker->head) {
+            worker->tail = NULL;
+        }
+        SDL_UnlockMutex(SDL_asyncio_lock);
+
+        SDL_RunAsyncIOTask(task);
+
+        SDL_LockMutex(SDL_asyncio_lock);
+        SDL_AtomicSet(&task->done, 1);
+        SDL_CondBroadcast(SDL_asyncio_done);
+    }
+    SDL_UnlockMutex(SDL_asyncio_lock);
+
+    return 0;
+}
+
+static int
+SDL_GetNumAsyncIOThreads(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_ASYNCIO_THREADS);
+    int count = hint ? SDL_atoi(hint) : 0;
+
+    if (count <= 0) {
+        count = DEFAULT_ASYNCIO_THREADS;
+    }
+    return SDL_min(count, MAX_ASYNCIO_THREADS);
+}
+
+static int
+SDL_InitAsyncIO(void)
+{
+    int i, count;
+
+    if (SDL_asyncio_workers) {
+        return 0;
+    }
+
+    count = SDL_GetNumAsyncIOThreads();
+    SDL_asyncio_quit = SDL_FALSE;
+    SDL_asyncio_lock = SDL_CreateMutex();
+    SDL_asyncio_done = SDL_CreateCond();
+    SDL_asyncio_workers = (SDL_AsyncIOWorker *)SDL_calloc(count, sizeof(*SDL_asyncio_workers));
+    if (!SDL_asyncio_lock || !SDL_asyncio_done || !SDL_asyncio_workers) {
+        SDL_QuitAsyncIO();
+        return SDL_OutOfMemory();
+    }
+
+    SDL_asyncio_num_workers = count;
+    for (i = 0; i < count; ++i) {
+        SDL_AsyncIOWorker *worker = &SDL_asyncio_workers[i];
+        char name[32];
+
+        SDL_snprintf(name, sizeof(name), "SDLAsyncIO%d", i);
+        worker->wakeup = SDL_CreateCond();
+        if (!worker->wakeup) {
+            SDL_QuitAsyncIO();
+            return SDL_OutOfMemory();
+        }
+        worker->thread = SDL_CreateThreadInternal(SDL_AsyncIOThread, name, 64 * 1024, worker);
+        if (!worker->thread) {
+            /* SDL_CreateThreadInternal() already set the error */
+            SDL_QuitAsyncIO();
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void
+SDL_QuitAsyncIO(void)
+{
+    int i;
+
+    if (SDL_asyncio_workers) {
+        SDL_LockMutex(SDL_asyncio_lock);
+        SDL_asyncio_quit = SDL_TRUE;
+        for (i = 0; i < SDL_asyncio_num_workers; ++i) {
+            if (SDL_asyncio_workers[i].wakeup) {
+                SDL_CondSignal(SDL_asyncio_workers[i].wakeup);
+            }
+        }
+        SDL_UnlockMutex(SDL_asyncio_lock);
+
+        /* The workers finish anything still queued before they exit */
+        for (i = 0; i < SDL_asyncio_num_workers; ++i) {
+            SDL_AsyncIOWorker *worker = &SDL_asyncio_workers[i];
+            if (worker->thread) {
+                SDL_WaitThread(worker->thread, NULL);
+            }
+            if (worker->wakeup) {
+                SDL_DestroyCond(worker->wakeup);
+            }
+        }
+        SDL_free(SDL_asyncio_workers);
+        SDL_asyncio_workers = NULL;
+        SDL_asyncio_num_workers = 0;
+    }
+    if (SDL_asyncio_done) {
+        SDL_DestroyCond(SDL_asyncio_done);
+        SDL_asyncio_done = NULL;
+    }
+    if (SDL_asyncio_lock) {
+        SDL_DestroyMutex(SDL_asyncio_lock);
+        SDL_asyncio_lock = NULL;
+    }
+}
+
+#else
+
+void
+SDL_QuitAsyncIO(void)
+{
+}
+
+#endif /* !SDL_THREADS_DISABLED */
+
+SDL_AsyncIOTask *
+SDL_RWreadAsync(SDL_RWops *context, Sint64 offset, void *ptr, size_t size)
+{
+    SDL_AsyncIOTask *task;
+
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return NULL;
+    }
+    if (!ptr && size > 0) {
+        SDL_InvalidParamError("ptr");
+        return NULL;
+    }
+
+    task = (SDL_AsyncIOTask *)SDL_calloc(1, sizeof(*task));
+    if (!task) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    task->context = context;
+    task->offset = offset;
+    task->ptr = ptr;
+    task->size = size;
+
+#if !SDL_THREADS_DISABLED
+    {
+        SDL_AsyncIOWorker *worker;
+        int status;
+
+        SDL_AtomicLock(&SDL_asyncio_init_lock);
+        status = SDL_InitAsyncIO();
+        SDL_AtomicUnlock(&SDL_asyncio_init_lock);
+        if (status < 0) {
+            SDL_free(task);
+            return NULL;
+        }
+
+        worker = &SDL_asyncio_workers[((uintptr_t)context / sizeof(*context)) % SDL_asyncio_num_workers];
+
+        SDL_LockMutex(SDL_asyncio_lock);
+        if (worker->tail) {
+            worker->tail->next = task;
+        } else {
+            worker->head = task;
+        }
+        worker->tail = task;
+        SDL_CondSignal(worker->wakeup);
+        SDL_UnlockMutex(SDL_asyncio_lock);
+    }
+#else
+    SDL_RunAsyncIOTask(task);
+    SDL_AtomicSet(&task->done, 1);
+#endif
+
+    return task;
+}
+
+SDL_bool
+SDL_AsyncIOTaskDone(SDL_AsyncIOTask *task)
+{
+    if (!task) {
+        SDL_InvalidParamError("task");
+        return SDL_FALSE;
+    }
+    return SDL_AtomicGet(&task->done) ? SDL_TRUE : SDL_FALSE;
+}
+
+Sint64
+SDL_WaitAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    Sint64 result;
+
+    if (!task) {
+        return SDL_InvalidParamError("task");
+    }
+
+#if !SDL_THREADS_DISABLED
+    if (!SDL_AtomicGet(&task->done)) {
+        SDL_LockMutex(SDL_asyncio_lock);
+        while (!SDL_AtomicGet(&task->done)) {
+            SDL_CondWait(SDL_asyncio_done, SDL_asyncio_lock);
+        }
+        SDL_UnlockMutex(SDL_asyncio_lock);
+    }
+#endif
+
+    result = task->result;
+    if (task->error) {
+        SDL_SetError("%s", task->error);
+        SDL_free(task->error);
+    }
+    SDL_free(task);
+
+    return result;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -42,6 +42,18 @@
 #include <limits.h>
 #endif
 
+#if (defined(__LINUX__) || defined(__MACOSX__) || defined(__FREEBSD__) || \
+     defined(__NETBSD__) || defined(__OPENBSD__)) && !defined(__ANDROID__)
+#define SDL_RWOPS_MMAP_POSIX 1
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(__WIN32__) && !defined(__WINRT__)
+#define SDL_RWOPS_MMAP_WINDOWS 1
+#endif
+
 /* This file provides a general interface for SDL to read and write
    data sources.  It can easily be extended to files, memory, etc.
 */
@@ -752,6 +764,271 @@ mem_close(SDL_RWops * context)
     return 0;
 }
 
+/* Functions to read memory-mapped files, these share the memory readers */
+
+#if defined(SDL_RWOPS_MMAP_POSIX) || defined(SDL_RWOPS_MMAP_WINDOWS)
+static int SDLCALL
+mapped_close(SDL_RWops * context)
+{
+    if (context) {
+#ifdef SDL_RWOPS_MMAP_POSIX
+        munmap(context->hidden.mem.base, (size_t)(context->hidden.mem.stop - context->hidden.mem.base));
+#else
+        UnmapViewOfFile(context->hidden.mem.base);
+#endif
+        SDL_FreeRW(context);
+    }
+    return 0;
+}
+
+/* Returns the mapped contents of the file, or NULL if it can't be mapped */
+static void *
+mapped_open(const char *file, size_t *size)
+{
+#ifdef SDL_RWOPS_MMAP_POSIX
+    struct stat st;
+    void *mem;
+    int fd = open(file, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+        (Uint64)st.st_size > (Uint64)(~(size_t)0)) {
+        close(fd);
+        return NULL;
+    }
+    mem = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  /* the mapping keeps its own reference to the file */
+    if (mem == MAP_FAILED) {
+        return NULL;
+    }
+    *size = (size_t)st.st_size;
+    return mem;
+#else
+    HANDLE h, mapping;
+    LARGE_INTEGER filesize;
+    UINT old_error_mode;
+    void *mem = NULL;
+    LPTSTR tstr = WIN_UTF8ToString(file);
+
+    /* Do not open a dialog box if failure */
+    old_error_mode = SetErrorMode(SEM_NOOPENFILEERRORBOX | SEM_FAILCRITICALERRORS);
+    h = CreateFile(tstr, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                   FILE_ATTRIBUTE_NORMAL, NULL);
+    SetErrorMode(old_error_mode);
+    SDL_free(tstr);
+
+    if (h == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+    if (!GetFileSizeEx(h, &filesize) || filesize.QuadPart <= 0 ||
+        (Uint64)filesize.QuadPart > (Uint64)(~(size_t)0)) {
+        CloseHandle(h);
+        return NULL;
+    }
+    mapping = CreateFileMapping(h, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping) {
+        mem = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        /* the view keeps the mapping and the file alive */
+        CloseHandle(mapping);
+    }
+    CloseHandle(h);
+    if (mem) {
+        *size = (size_t)filesize.QuadPart;
+    }
+    return mem;
+#endif
+}
+#endif /* SDL_RWOPS_MMAP_POSIX || SDL_RWOPS_MMAP_WINDOWS */
+
+/* Functions to buffer reads and writes on top of another SDL_RWops */
+
+#define DEFAULT_BUFFERED_SIZE   4096
+
+typedef struct
+{
+    SDL_RWops *inner;
+    Uint8 *data;
+    size_t size;    /* capacity of data */
+    size_t pos;     /* next byte to read from data */
+    size_t len;     /* number of bytes read ahead into data */
+    size_t dirty;   /* number of bytes written to data but not to inner */
+} SDL_RWopsBuffer;
+
+static int
+buffered_flush(SDL_RWopsBuffer *buffer)
+{
+    if (buffer->dirty) {
+        const size_t written = SDL_RWwrite(buffer->inner, buffer->data, 1, buffer->dirty);
+        if (written != buffer->dirty) {
+            /* Keep whatever didn't make it, so a later flush can retry */
+            if (written > 0 && written < buffer->dirty) {
+                SDL_memmove(buffer->data, buffer->data + written, buffer->dirty - written);
+                buffer->dirty -= written;
+            }
+            return SDL_Error(SDL_EFWRITE);
+        }
+        buffer->dirty = 0;
+    }
+    return 0;
+}
+
+/* Throw away any read-ahead data, moving the inner stream back to the logical position */
+static int
+buffered_unread(SDL_RWopsBuffer *buffer)
+{
+    const size_t unread = buffer->len - buffer->pos;
+    buffer->pos = buffer->len = 0;
+    if (unread && SDL_RWseek(buffer->inner, -(Sint64)unread, RW_SEEK_CUR) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static Sint64 SDLCALL
+buffered_size(SDL_RWops * context)
+{
+    SDL_RWopsBuffer *buffer = (SDL_RWopsBuffer *) context->hidden.unknown.data1;
+
+    if (buffered_flush(buffer) < 0) {
+        return -1;
+    }
+    return SDL_RWsize(buffer->inner);
+}
+
+static Sint64 SDLCALL
+buffered_seek(SDL_RWops * context, Sint64 offset, int whence)
+{
+    SDL_RWopsBuffer *buffer = (SDL_RWopsBuffer *) context->hidden.unknown.data1;
+
+    if (buffered_flush(buffer) < 0) {
+        return -1;
+    }
+
+    if (whence == RW_SEEK_CUR) {
+        /* Seeking within the read-ahead data doesn't touch the inner stream */
+        if (offset >= -(Sint64)buffer->pos && offset <= (Sint64)(buffer->len - buffer->pos)) {
+            Sint64 pos = SDL_RWseek(buffer->inner, 0, RW_SEEK_CUR);
+            if (pos < 0) {
+                return -1;
+            }
+            buffer->pos = (size_t)((Sint64)buffer->pos + offset);
+            return pos - (Sint64)(buffer->len - buffer->pos);
+        }
+        offset -= (Sint64)(buffer->len - buffer->pos);
+    }
+    buffer->pos = buffer->len = 0;
+    return SDL_RWseek(buffer->inner, offset, whence);
+}
+
+static size_t SDLCALL
+buffered_read(SDL_RWops * context, void *ptr, size_t size, size_t maxnum)
+{
+    SDL_RWopsBuffer *buffer = (SDL_RWopsBuffer *) context->hidden.unknown.data1;
+    size_t total_bytes, total_read = 0;
+
+    total_bytes = (maxnum * size);
+    if ((maxnum <= 0) || (size <= 0)
+        || ((total_bytes / maxnum) != size)) {
+        return 0;
+    }
+
+    if (buffered_flush(buffer) < 0) {
+        return 0;
+    }
+
+    while (total_read < total_bytes) {
+        size_t avail = buffer->len - buffer->pos;
+        if (avail == 0) {
+            const size_t need = total_bytes - total_read;
+            size_t nread;
+
+            /* Large reads go straight to the caller's memory */
+            if (need >= buffer->size) {
+                nread = SDL_RWread(buffer->inner, (Uint8 *)ptr + total_read, 1, need);
+                total_read += nread;
+                break;
+            }
+
+            nread = SDL_RWread(buffer->inner, buffer->data, 1, buffer->size);
+            if (nread == 0) {
+                break;
+            }
+            buffer->pos = 0;
+            buffer->len = avail = nread;
+        }
+
+        avail = SDL_min(avail, total_bytes - total_read);
+        SDL_memcpy((Uint8 *)ptr + total_read, buffer->data + buffer->pos, avail);
+        buffer->pos += avail;
+        total_read += avail;
+    }
+    return (total_read / size);
+}
+
+static size_t SDLCALL
+buffered_write(SDL_RWops * context, const void *ptr, size_t size, size_t num)
+{
+    SDL_RWopsBuffer *buffer = (SDL_RWopsBuffer *) context->hidden.unknown.data1;
+    size_t total_bytes;
+
+    total_bytes = (num * size);
+    if ((num <= 0) || (size <= 0)
+        || ((total_bytes / num) != size)) {
+        return 0;
+    }
+
+    if (buffered_unread(buffer) < 0) {
+        return 0;
+    }
+
+    if (buffer->dirty + total_bytes > buffer->size) {
+        if (buffered_flush(buffer) < 0) {
+            return 0;
+        }
+        /* Large writes go straight to the inner stream */
+        if (total_bytes >= buffer->size) {
+            return SDL_RWwrite(buffer->inner, ptr, size, num);
+        }
+    }
+    SDL_memcpy(buffer->data + buffer->dirty, ptr, total_bytes);
+    buffer->dirty += total_bytes;
+    return num;
+}
+
+static int SDLCALL
+buffered_close(SDL_RWops * context)
+{
+    int status = 0;
+    if (context) {
+        SDL_RWopsBuffer *buffer = (SDL_RWopsBuffer *) context->hidden.unknown.data1;
+
+        status = buffered_flush(buffer);
+        if (SDL_RWclose(buffer->inner) < 0) {
+            status = -1;
+        }
+        SDL_free(buffer->data);
+        SDL_free(buffer);
+        SDL_FreeRW(context);
+    }
+    return status;
+}
+
+/* Read small values straight out of the read-ahead buffer, if possible */
+static SDL_INLINE SDL_bool
+buffered_read_fast(SDL_RWops * context, void *ptr, size_t size)
+{
+    if (context->read == buffered_read) {
+        SDL_RWopsBuffer *buffer = (SDL_RWopsBuffer *) context->hidden.unknown.data1;
+        if ((buffer->len - buffer->pos) >= size) {
+            SDL_memcpy(ptr, buffer->data + buffer->pos, size);
+            buffer->pos += size;
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
 
 /* Functions to create SDL_RWops structures from various data sources */
 
@@ -940,6 +1217,93 @@ SDL_RWFromConstMem(const void *mem, int size)
     return rwops;
 }
 
+SDL_RWops *
+SDL_RWFromFileMapped(const char *file)
+{
+#if defined(SDL_RWOPS_MMAP_POSIX) || defined(SDL_RWOPS_MMAP_WINDOWS)
+    SDL_RWops *rwops;
+    size_t size = 0;
+    void *mem;
+#endif
+
+    if (!file || !*file) {
+        SDL_SetError("SDL_RWFromFileMapped(): No file specified");
+        return NULL;
+    }
+
+#if defined(SDL_RWOPS_MMAP_POSIX) || defined(SDL_RWOPS_MMAP_WINDOWS)
+    mem = mapped_open(file, &size);
+    if (mem) {
+        rwops = SDL_AllocRW();
+        if (rwops == NULL) {
+#ifdef SDL_RWOPS_MMAP_POSIX
+            munmap(mem, size);
+#else
+            UnmapViewOfFile(mem);
+#endif
+            return NULL;
+        }
+        rwops->size = mem_size;
+        rwops->seek = mem_seek;
+        rwops->read = mem_read;
+        rwops->write = mem_writeconst;
+        rwops->close = mapped_close;
+        rwops->hidden.mem.base = (Uint8 *) mem;
+        rwops->hidden.mem.here = rwops->hidden.mem.base;
+        rwops->hidden.mem.stop = rwops->hidden.mem.base + size;
+        rwops->type = SDL_RWOPS_MEMORY_RO;
+        return rwops;
+    }
+#endif
+
+    /* Empty files, special files and platforms without mmap get a normal stream */
+    return SDL_RWFromFile(file, "rb");
+}
+
+SDL_RWops *
+SDL_RWFromBuffered(SDL_RWops *inner, size_t bufsize)
+{
+    SDL_RWops *rwops;
+    SDL_RWopsBuffer *buffer;
+
+    if (!inner) {
+        SDL_InvalidParamError("inner");
+        return NULL;
+    }
+    if (!bufsize) {
+        bufsize = DEFAULT_BUFFERED_SIZE;
+    }
+
+    buffer = (SDL_RWopsBuffer *) SDL_calloc(1, sizeof(*buffer));
+    if (!buffer) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    buffer->data = (Uint8 *) SDL_malloc(bufsize);
+    if (!buffer->data) {
+        SDL_free(buffer);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    buffer->inner = inner;
+    buffer->size = bufsize;
+
+    rwops = SDL_AllocRW();
+    if (rwops == NULL) {
+        SDL_free(buffer->data);
+        SDL_free(buffer);
+        return NULL;
+    }
+    rwops->size = buffered_size;
+    rwops->seek = buffered_seek;
+    rwops->read = buffered_read;
+    rwops->write = buffered_write;
+    rwops->close = buffered_close;
+    rwops->hidden.unknown.data1 = buffer;
+    rwops->hidden.unknown.data2 = inner;
+    return rwops;
+}
+
 SDL_RWops *
 SDL_AllocRW(void)
 {
@@ -974,16 +1338,39 @@ SDL_LoadFile_RW(SDL_RWops * src, size_t *datasize, int freesrc)
         return NULL;
     }
 
+    /* Memory streams (including mapped files) can be copied in one go */
+    if (src->type == SDL_RWOPS_MEMORY || src->type == SDL_RWOPS_MEMORY_RO) {
+        size_total = (size_t)(src->hidden.mem.stop - src->hidden.mem.here);
+        data = SDL_malloc(size_total + 1);
+        if (!data) {
+            SDL_OutOfMemory();
+            goto done;
+        }
+        SDL_memcpy(data, src->hidden.mem.here, size_total);
+        src->hidden.mem.here += size_total;
+        goto finished;
+    }
+
     size = SDL_RWsize(src);
     if (size < 0) {
         size = FILE_CHUNK_SIZE;
     }
     data = SDL_malloc((size_t)(size + 1));
+    if (!data) {
+        SDL_OutOfMemory();
+        goto done;
+    }
 
     size_total = 0;
     for (;;) {
-        if ((((Sint64)size_total) + FILE_CHUNK_SIZE) > size) {
-            size = (size_total + FILE_CHUNK_SIZE);
+        if (((Sint64)size_total) == size) {
+            /* The buffer is full; make sure there is actually more data
+               before growing it, which would copy everything read so far. */
+            Uint8 probe;
+            if (SDL_RWread(src, &probe, 1, 1) == 0) {
+                break;
+            }
+            size = (size_total + SDL_max(size_total, (size_t)FILE_CHUNK_SIZE));
             newdata = SDL_realloc(data, (size_t)(size + 1));
             if (!newdata) {
                 SDL_free(data);
@@ -992,6 +1379,8 @@ SDL_LoadFile_RW(SDL_RWops * src, size_t *datasize, int freesrc)
                 goto done;
             }
             data = newdata;
+            ((Uint8 *)data)[size_total++] = probe;
+            continue;
         }
 
         size_read = SDL_RWread(src, (char *)data+size_total, 1, (size_t)(size-size_total));
@@ -1001,6 +1390,7 @@ SDL_LoadFile_RW(SDL_RWops * src, size_t *datasize, int freesrc)
         size_total += size_read;
     }
 
+finished:
     if (datasize) {
         *datasize = size_total;
     }
@@ -1062,7 +1452,9 @@ SDL_ReadU8(SDL_RWops * src)
 {
     Uint8 value = 0;
 
-    SDL_RWread(src, &value, sizeof (value), 1);
+    if (!buffered_read_fast(src, &value, sizeof (value))) {
+        SDL_RWread(src, &value, sizeof (value), 1);
+    }
     return value;
 }
 
@@ -1071,7 +1463,9 @@ SDL_ReadLE16(SDL_RWops * src)
 {
     Uint16 value = 0;
 
-    SDL_RWread(src, &value, sizeof (value), 1);
+    if (!buffered_read_fast(src, &value, sizeof (value))) {
+        SDL_RWread(src, &value, sizeof (value), 1);
+    }
     return SDL_SwapLE16(value);
 }
 
@@ -1080,7 +1474,9 @@ SDL_ReadBE16(SDL_RWops * src)
 {
     Uint16 value = 0;
 
-    SDL_RWread(src, &value, sizeof (value), 1);
+    if (!buffered_read_fast(src, &value, sizeof (value))) {
+        SDL_RWread(src, &value, sizeof (value), 1);
+    }
     return SDL_SwapBE16(value);
 }
 
@@ -1089,7 +1485,9 @@ SDL_ReadLE32(SDL_RWops * src)
 {
     Uint32 value = 0;
 
-    SDL_RWread(src, &value, sizeof (value), 1);
+    if (!buffered_read_fast(src, &value, sizeof (value))) {
+        SDL_RWread(src, &value, sizeof (value), 1);
+    }
     return SDL_SwapLE32(value);
 }
 
@@ -1098,7 +1496,9 @@ SDL_ReadBE32(SDL_RWops * src)
 {
     Uint32 value = 0;
 
-    SDL_RWread(src, &value, sizeof (value), 1);
+    if (!buffered_read_fast(src, &value, sizeof (value))) {
+        SDL_RWread(src, &value, sizeof (value), 1);
+    }
     return SDL_SwapBE32(value);
 }
 
@@ -1107,7 +1507,9 @@ SDL_ReadLE64(SDL_RWops * src)
 {
     Uint64 value = 0;
 
-    SDL_RWread(src, &value, sizeof (value), 1);
+    if (!buffered_read_fast(src, &value, sizeof (value))) {
+        SDL_RWread(src, &value, sizeof (value), 1);
+    }
     return SDL_SwapLE64(value);
 }
 
@@ -1116,7 +1518,9 @@ SDL_ReadBE64(SDL_RWops * src)
 {
     Uint64 value = 0;
 
-    SDL_RWread(src, &value, sizeof (value), 1);
+    if (!buffered_read_fast(src, &value, sizeof (value))) {
+        SDL_RWread(src, &value, sizeof (value), 1);
+    }
     return SDL_SwapBE64(value);
 }
 
@@ -49,6 +49,8 @@
 
 /* a list of currently opened game controllers */
 static SDL_GameController *SDL_gamecontrollers = NULL;
+static SDL_GameController *SDL_gamecontroller_hash[64];    /* open controllers by joystick instance ID */
+#define SDL_GAMECONTROLLER_HASH(instance_id) ((Uint32)(instance_id) % SDL_arraysize(SDL_gamecontroller_hash))
 
 typedef struct
 {
@@ -98,12 +100,20 @@ typedef struct _ControllerMapping_t
     SDL_JoystickGUID guid;
     char *name;
     char *mapping;
+    const char *source;     /* built-in mapping string, name and mapping are parsed from it when first needed */
     SDL_ControllerMappingPriority priority;
     struct _ControllerMapping_t *next;
+    struct _ControllerMapping_t *hash_next;
 } ControllerMapping_t;
 
+/* Mappings are also kept in a hash table by GUID, so lookups and adds don't
+   have to walk the whole list */
+#define CONTROLLER_MAPPING_HASH_SIZE 1024
+
 static SDL_JoystickGUID s_zeroGUID;
 static ControllerMapping_t *s_pSupportedControllers = NULL;
+static ControllerMapping_t *s_pSupportedControllersTail = NULL;
+static ControllerMapping_t *s_pMappingHash[CONTROLLER_MAPPING_HASH_SIZE];
 static ControllerMapping_t *s_pDefaultMapping = NULL;
 static ControllerMapping_t *s_pXInputMapping = NULL;
 
@@ -120,7 +130,14 @@ struct _SDL_GameController
     Uint8 *last_hat_mask;
     Uint32 guide_button_down;
 
+    /* The bindings for each joystick axis, then each button, then each hat,
+       in mapping order: input N uses input_bindings[input_start[N]] up to
+       input_bindings[input_start[N + 1]] */
+    SDL_ExtendedGameControllerBind **input_bindings;
+    int *input_start;
+
     struct _SDL_GameController *next; /* pointer to next game controller we have allocated */
+    struct _SDL_GameController *hash_next; /* next controller in the same instance ID hash bucket */
 };
 
 
@@ -193,6 +210,8 @@ SDL_GameControllerIgnoreDevicesExceptChanged(void *userdata, const char *name, c
 }
 
 static ControllerMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString, SDL_bool *existing, SDL_ControllerMappingPriority priority);
+static char *SDL_PrivateGetControllerNameFromMappingString(const char *pMapping);
+static char *SDL_PrivateGetControllerMappingFromMappingString(const char *pMapping);
 static int SDL_PrivateGameControllerAxis(SDL_GameController *gamecontroller, SDL_GameControllerAxis axis, Sint16 value);
 static int SDL_PrivateGameControllerButton(SDL_GameController *gamecontroller, SDL_GameControllerButton button, Uint8 state);
 
@@ -262,26 +281,24 @@ static void ResetOutput(SDL_GameController *gamecontroller, SDL_ExtendedGameCont
 
 static void HandleJoystickAxis(SDL_GameController *gamecontroller, int axis, int value)
 {
-    int i;
+    int i, end;
     SDL_ExtendedGameControllerBind *last_match = gamecontroller->last_match_axis[axis];
     SDL_ExtendedGameControllerBind *match = NULL;
 
-    for (i = 0; i < gamecontroller->num_bindings; ++i) {
-        SDL_ExtendedGameControllerBind *binding = &gamecontroller->bindings[i];
-        if (binding->inputType == SDL_CONTROLLER_BINDTYPE_AXIS &&
-            axis == binding->input.axis.axis) {
-            if (binding->input.axis.axis_min < binding->input.axis.axis_max) {
-                if (value >= binding->input.axis.axis_min &&
-                    value <= binding->input.axis.axis_max) {
-                    match = binding;
-                    break;
-                }
-            } else {
-                if (value >= binding->input.axis.axis_max &&
-                    value <= binding->input.axis.axis_min) {
-                    match = binding;
-                    break;
-                }
+    end = gamecontroller->input_start[axis + 1];
+    for (i = gamecontroller->input_start[axis]; i < end; ++i) {
+        SDL_ExtendedGameControllerBind *binding = gamecontroller->input_bindings[i];
+        if (binding->input.axis.axis_min < binding->input.axis.axis_max) {
+            if (value >= binding->input.axis.axis_min &&
+                value <= binding->input.axis.axis_max) {
+                match = binding;
+                break;
+            }
+        } else {
+            if (value >= binding->input.axis.axis_max &&
+                value <= binding->input.axis.axis_min) {
+                match = binding;
+                break;
             }
         }
     }
@@ -314,42 +331,39 @@ static void HandleJoystickAxis(SDL_GameController *gamecontroller, int axis, int
 
 static void HandleJoystickButton(SDL_GameController *gamecontroller, int button, Uint8 state)
 {
-    int i;
+    const int input = gamecontroller->joystick->naxes + button;
 
-    for (i = 0; i < gamecontroller->num_bindings; ++i) {
-        SDL_ExtendedGameControllerBind *binding = &gamecontroller->bindings[i];
-        if (binding->inputType == SDL_CONTROLLER_BINDTYPE_BUTTON &&
-            button == binding->input.button) {
-            if (binding->outputType == SDL_CONTROLLER_BINDTYPE_AXIS) {
-                int value = state ? binding->output.axis.axis_max : binding->output.axis.axis_min;
-                SDL_PrivateGameControllerAxis(gamecontroller, binding->output.axis.axis, (Sint16)value);
-            } else {
-                SDL_PrivateGameControllerButton(gamecontroller, binding->output.button, state);
-            }
-            break;
+    /* Only the first binding for a button is used */
+    if (gamecontroller->input_start[input] < gamecontroller->input_start[input + 1]) {
+        SDL_ExtendedGameControllerBind *binding = gamecontroller->input_bindings[gamecontroller->input_start[input]];
+        if (binding->outputType == SDL_CONTROLLER_BINDTYPE_AXIS) {
+            int value = state ? binding->output.axis.axis_max : binding->output.axis.axis_min;
+            SDL_PrivateGameControllerAxis(gamecontroller, binding->output.axis.axis, (Sint16)value);
+        } else {
+            SDL_PrivateGameControllerButton(gamecontroller, binding->output.button, state);
         }
     }
 }
 
 static void HandleJoystickHat(SDL_GameController *gamecontroller, int hat, Uint8 value)
 {
-    int i;
+    int i, end;
+    const int input = gamecontroller->joystick->naxes + gamecontroller->joystick->nbuttons + hat;
     Uint8 last_mask = gamecontroller->last_hat_mask[hat];
     Uint8 changed_mask = (last_mask ^ value);
 
-    for (i = 0; i < gamecontroller->num_bindings; ++i) {
-        SDL_ExtendedGameControllerBind *binding = &gamecontroller->bindings[i];
-        if (binding->inputType == SDL_CONTROLLER_BINDTYPE_HAT && hat == binding->input.hat.hat) {
-            if ((changed_mask & binding->input.hat.hat_mask) != 0) {
-                if (value & binding->input.hat.hat_mask) {
-                    if (binding->outputType == SDL_CONTROLLER_BINDTYPE_AXIS) {
-                        SDL_PrivateGameControllerAxis(gamecontroller, binding->output.axis.axis, (Sint16)binding->output.axis.axis_max);
-                    } else {
-                        SDL_PrivateGameControllerButton(gamecontroller, binding->output.button, SDL_PRESSED);
-                    }
+    end = gamecontroller->input_start[input + 1];
+    for (i = gamecontroller->input_start[input]; i < end; ++i) {
+        SDL_ExtendedGameControllerBind *binding = gamecontroller->input_bindings[i];
+        if ((changed_mask & binding->input.hat.hat_mask) != 0) {
+            if (value & binding->input.hat.hat_mask) {
+                if (binding->outputType == SDL_CONTROLLER_BINDTYPE_AXIS) {
+                    SDL_PrivateGameControllerAxis(gamecontroller, binding->output.axis.axis, (Sint16)binding->output.axis.axis_max);
                 } else {
-                    ResetOutput(gamecontroller, binding);
+                    SDL_PrivateGameControllerButton(gamecontroller, binding->output.button, SDL_PRESSED);
                 }
+            } else {
+                ResetOutput(gamecontroller, binding);
             }
         }
     }
@@ -382,6 +396,22 @@ static void RecenterGameController(SDL_GameController *gamecontroller)
 }
 
 
+/*
+ * Helper function to find an open controller by its joystick instance ID
+ */
+static SDL_GameController *SDL_PrivateGameControllerForInstanceID(SDL_JoystickID joyid)
+{
+    SDL_GameController *gamecontroller = SDL_gamecontroller_hash[SDL_GAMECONTROLLER_HASH(joyid)];
+
+    while (gamecontroller) {
+        if (gamecontroller->joystick->instance_id == joyid) {
+            break;
+        }
+        gamecontroller = gamecontroller->hash_next;
+    }
+    return gamecontroller;
+}
+
 /*
  * Event filter to fire controller events from joystick ones
  */
@@ -390,38 +420,26 @@ static int SDLCALL SDL_GameControllerEventWatcher(void *userdata, SDL_Event * ev
     switch(event->type) {
     case SDL_JOYAXISMOTION:
         {
-            SDL_GameController *controllerlist = SDL_gamecontrollers;
-            while (controllerlist) {
-                if (controllerlist->joystick->instance_id == event->jaxis.which) {
-                    HandleJoystickAxis(controllerlist, event->jaxis.axis, event->jaxis.value);
-                    break;
-                }
-                controllerlist = controllerlist->next;
+            SDL_GameController *gamecontroller = SDL_PrivateGameControllerForInstanceID(event->jaxis.which);
+            if (gamecontroller && gamecontroller->input_start) {
+                HandleJoystickAxis(gamecontroller, event->jaxis.axis, event->jaxis.value);
             }
         }
         break;
     case SDL_JOYBUTTONDOWN:
     case SDL_JOYBUTTONUP:
         {
-            SDL_GameController *controllerlist = SDL_gamecontrollers;
-            while (controllerlist) {
-                if (controllerlist->joystick->instance_id == event->jbutton.which) {
-                    HandleJoystickButton(controllerlist, event->jbutton.button, event->jbutton.state);
-                    break;
-                }
-                controllerlist = controllerlist->next;
+            SDL_GameController *gamecontroller = SDL_PrivateGameControllerForInstanceID(event->jbutton.which);
+            if (gamecontroller && gamecontroller->input_start) {
+                HandleJoystickButton(gamecontroller, event->jbutton.button, event->jbutton.state);
             }
         }
         break;
     case SDL_JOYHATMOTION:
         {
-            SDL_GameController *controllerlist = SDL_gamecontrollers;
-            while (controllerlist) {
-                if (controllerlist->joystick->instance_id == event->jhat.which) {
-                    HandleJoystickHat(controllerlist, event->jhat.hat, event->jhat.value);
-                    break;
-                }
-                controllerlist = controllerlist->next;
+            SDL_GameController *gamecontroller = SDL_PrivateGameControllerForInstanceID(event->jhat.which);
+            if (gamecontroller && gamecontroller->input_start) {
+                HandleJoystickHat(gamecontroller, event->jhat.hat, event->jhat.value);
             }
         }
         break;
@@ -657,24 +675,102 @@ static ControllerMapping_t *SDL_CreateMappingForRAWINPUTController(SDL_JoystickG
 }
 
 /*
- * Helper function to scan the mappings database for a controller with the specified GUID
+ * Helper function to find the hash table bucket for a GUID
  */
-static ControllerMapping_t *SDL_PrivateGetControllerMappingForGUID(SDL_JoystickGUID guid, SDL_bool exact_match)
+static ControllerMapping_t **SDL_PrivateGetMappingHashBucket(SDL_JoystickGUID guid)
+{
+    Uint32 hash = 2166136261u;
+    int i;
+
+    /* FNV-1a */
+    for (i = 0; i < sizeof(guid.data); ++i) {
+        hash = (hash ^ guid.data[i]) * 16777619u;
+    }
+    return &s_pMappingHash[hash % CONTROLLER_MAPPING_HASH_SIZE];
+}
+
+/*
+ * Helper function to find the mapping for a GUID, without parsing it
+ */
+static ControllerMapping_t *SDL_PrivateFindMappingForGUID(SDL_JoystickGUID guid)
 {
-    ControllerMapping_t *mapping = s_pSupportedControllers;
+    ControllerMapping_t *mapping = *SDL_PrivateGetMappingHashBucket(guid);
 
     while (mapping) {
         if (SDL_memcmp(&guid, &mapping->guid, sizeof(guid)) == 0) {
             return mapping;
         }
-        mapping = mapping->next;
+        mapping = mapping->hash_next;
+    }
+    return NULL;
+}
+
+/*
+ * Helper function to add a new mapping to the end of the list and to the hash table
+ */
+static void SDL_PrivateInsertMapping(ControllerMapping_t *mapping)
+{
+    ControllerMapping_t **bucket = SDL_PrivateGetMappingHashBucket(mapping->guid);
+
+    mapping->next = NULL;
+    if (s_pSupportedControllersTail) {
+        s_pSupportedControllersTail->next = mapping;
+    } else {
+        s_pSupportedControllers = mapping;
+    }
+    s_pSupportedControllersTail = mapping;
+
+    mapping->hash_next = *bucket;
+    *bucket = mapping;
+}
+
+/*
+ * Helper function to parse the name and mapping of a built-in mapping the first time they're needed
+ *
+ * This is reached from queries on any thread, so the joysticks are locked
+ * to keep two threads from parsing the same mapping or seeing it half done.
+ */
+static ControllerMapping_t *SDL_PrivateLoadMapping(ControllerMapping_t *mapping)
+{
+    if (!mapping) {
+        return NULL;
+    }
+
+    SDL_LockJoysticks();
+    if (!mapping->name) {
+        char *name = SDL_PrivateGetControllerNameFromMappingString(mapping->source);
+        char *pchMapping = SDL_PrivateGetControllerMappingFromMappingString(mapping->source);
+        if (!name || !pchMapping) {
+            SDL_free(name);
+            SDL_free(pchMapping);
+            SDL_SetError("Couldn't parse %s", mapping->source);
+            mapping = NULL;
+        } else {
+            mapping->mapping = pchMapping;
+            mapping->name = name;
+        }
+    }
+    SDL_UnlockJoysticks();
+
+    return mapping;
+}
+
+/*
+ * Helper function to scan the mappings database for a controller with the specified GUID
+ */
+static ControllerMapping_t *SDL_PrivateGetControllerMappingForGUID(SDL_JoystickGUID guid, SDL_bool exact_match)
+{
+    ControllerMapping_t *mapping = SDL_PrivateFindMappingForGUID(guid);
+
+    if (mapping) {
+        return SDL_PrivateLoadMapping(mapping);
     }
 
     if (!exact_match) {
 #if SDL_JOYSTICK_XINPUT
         if (SDL_IsJoystickXInput(guid)) {
             /* This is an XInput device */
-            return s_pXInputMapping;
+            return SDL_PrivateLoadMapping(s_pXInputMapping);
         }
 #endif
 #ifdef __ANDROID__
@@ -934,6 +1030,83 @@ SDL_PrivateGameControllerParseControllerConfigString(SDL_GameController *gamecon
     }
 }
 
+/*
+ * Helper function to get the slot in input_start for the joystick input a binding reads, or -1 if it doesn't exist
+ */
+static int GetBindingInput(SDL_Joystick *joystick, const SDL_ExtendedGameControllerBind *binding)
+{
+    switch (binding->inputType) {
+    case SDL_CONTROLLER_BINDTYPE_AXIS:
+        if (binding->input.axis.axis >= 0 && binding->input.axis.axis < joystick->naxes) {
+            return binding->input.axis.axis;
+        }
+        break;
+    case SDL_CONTROLLER_BINDTYPE_BUTTON:
+        if (binding->input.button >= 0 && binding->input.button < joystick->nbuttons) {
+            return joystick->naxes + binding->input.button;
+        }
+        break;
+    case SDL_CONTROLLER_BINDTYPE_HAT:
+        if (binding->input.hat.hat >= 0 && binding->input.hat.hat < joystick->nhats) {
+            return joystick->naxes + joystick->nbuttons + binding->input.hat.hat;
+        }
+        break;
+    default:
+        break;
+    }
+    return -1;
+}
+
+/*
+ * Helper function to group the bindings by the joystick input they read, so
+ * events only look at the bindings for their own axis, button or hat
+ */
+static void SDL_PrivateGameControllerIndexBindings(SDL_GameController *gamecontroller)
+{
+    SDL_Joystick *joystick = gamecontroller->joystick;
+    const int num_inputs = joystick->naxes + joystick->nbuttons + joystick->nhats;
+    int *input_start;
+    int i;
+
+    SDL_free(gamecontroller->input_bindings);
+    gamecontroller->input_bindings = NULL;
+    SDL_free(gamecontroller->input_start);
+
+    input_start = (int *)SDL_calloc(num_inputs + 2, sizeof(*input_start));
+    gamecontroller->input_start = input_start;
+    if (!input_start) {
+        SDL_OutOfMemory();
+        return;
+    }
+
+    /* Count the bindings for each input, shifted up by one... */
+    for (i = 0; i < gamecontroller->num_bindings; ++i) {
+        const int input = GetBindingInput(joystick, &gamecontroller->bindings[i]);
+        if (input >= 0) {
+            ++input_start[input + 2];
+        }
+    }
+    /* ...turn that into where each input's bindings start, still shifted... */
+    for (i = 2; i < num_inputs + 2; ++i) {
+        input_start[i] += input_start[i - 1];
+    }
+    if (input_start[num_inputs + 1] > 0) {
+        gamecontroller->input_bindings = (SDL_ExtendedGameControllerBind **)SDL_malloc(input_start[num_inputs + 1] * sizeof(*gamecontroller->input_bindings));
+        if (!gamecontroller->input_bindings) {
+            SDL_OutOfMemory();
+            SDL_memset(input_start, 0, (num_inputs + 2) * sizeof(*input_start));
+            return;
+        }
+    }
+    /* ...and fill them in, which moves each start back into place */
+    for (i = 0; i < gamecontroller->num_bindings; ++i) {
+        const int input = GetBindingInput(joystick, &gamecontroller->bindings[i]);
+        if (input >= 0) {
+            gamecontroller->input_bindings[input_start[input + 1]++] = &gamecontroller->bindings[i];
+        }
+    }
+}
+
 /*
  * Make a new button mapping struct
  */
@@ -948,6 +1121,7 @@ static void SDL_PrivateLoadButtonMapping(SDL_GameController *gamecontroller, con
     }
 
     SDL_PrivateGameControllerParseControllerConfigString(gamecontroller, pchMapping);
+    SDL_PrivateGameControllerIndexBindings(gamecontroller);
 
     /* Set the zero point for triggers */
     for (i = 0; i < gamecontroller->num_bindings; ++i) {
@@ -1095,7 +1269,7 @@ SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString,
         return NULL;
     }
 
-    pControllerMapping = SDL_PrivateGetControllerMappingForGUID(jGUID, SDL_TRUE);
+    pControllerMapping = SDL_PrivateFindMappingForGUID(jGUID);
     if (pControllerMapping) {
         /* Only overwrite the mapping if the priority is the same or higher. */
         if (pControllerMapping->priority <= priority) {
@@ -1104,6 +1278,7 @@ SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString,
             pControllerMapping->name = pchName;
             SDL_free(pControllerMapping->mapping);
             pControllerMapping->mapping = pchMapping;
+            pControllerMapping->source = NULL;
             pControllerMapping->priority = priority;
             /* refresh open controllers */
             SDL_PrivateGameControllerRefreshMapping(pControllerMapping);
@@ -1123,22 +1298,51 @@ SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString,
         pControllerMapping->guid = jGUID;
         pControllerMapping->name = pchName;
         pControllerMapping->mapping = pchMapping;
-        pControllerMapping->next = NULL;
+        pControllerMapping->source = NULL;
         pControllerMapping->priority = priority;
+        SDL_PrivateInsertMapping(pControllerMapping);
+        *existing = SDL_FALSE;
+    }
+    return pControllerMapping;
+}
 
-        if (s_pSupportedControllers) {
-            /* Add the mapping to the end of the list */
-            ControllerMapping_t *pCurrMapping, *pPrevMapping;
+/*
+ * Helper function to add a mapping from the built-in database for a guid.
+ * The string is static, so it is only parsed once the mapping is used.
+ */
+static ControllerMapping_t *
+SDL_PrivateAddBuiltinMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString, SDL_bool *existing)
+{
+    ControllerMapping_t *pControllerMapping;
 
-            for ( pPrevMapping = s_pSupportedControllers, pCurrMapping = pPrevMapping->next;
-                  pCurrMapping; 
-                  pPrevMapping = pCurrMapping, pCurrMapping = pCurrMapping->next ) {
-                /* continue; */
+    pControllerMapping = SDL_PrivateFindMappingForGUID(jGUID);
+    if (pControllerMapping) {
+        if (pControllerMapping->priority == SDL_CONTROLLER_MAPPING_PRIORITY_DEFAULT) {
+            /* Update existing mapping */
+            SDL_free(pControllerMapping->name);
+            pControllerMapping->name = NULL;
+            SDL_free(pControllerMapping->mapping);
+            pControllerMapping->mapping = NULL;
+            pControllerMapping->source = mappingString;
+            if (SDL_gamecontrollers) {
+                /* refresh open controllers */
+                if (!SDL_PrivateLoadMapping(pControllerMapping)) {
+                    return NULL;
+                }
+                SDL_PrivateGameControllerRefreshMapping(pControllerMapping);
             }
-            pPrevMapping->next = pControllerMapping;
-        } else {
-            s_pSupportedControllers = pControllerMapping;
         }
+        *existing = SDL_TRUE;
+    } else {
+        pControllerMapping = SDL_calloc(1, sizeof(*pControllerMapping));
+        if (!pControllerMapping) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        pControllerMapping->guid = jGUID;
+        pControllerMapping->source = mappingString;
+        pControllerMapping->priority = SDL_CONTROLLER_MAPPING_PRIORITY_DEFAULT;
+        SDL_PrivateInsertMapping(pControllerMapping);
         *existing = SDL_FALSE;
     }
     return pControllerMapping;
@@ -1166,11 +1370,11 @@ static ControllerMapping_t *SDL_PrivateGetControllerMappingForNameAndGUID(const
 
     if (!mapping && name && !SDL_IsJoystickWGI(guid)) {
         if (SDL_strstr(name, "Xbox") || SDL_strstr(name, "X-Box") || SDL_strstr(name, "XBOX")) {
-            mapping = s_pXInputMapping;
+            mapping = SDL_PrivateLoadMapping(s_pXInputMapping);
         }
     }
     if (!mapping) {
-        mapping = s_pDefaultMapping;
+        mapping = SDL_PrivateLoadMapping(s_pDefaultMapping);
     }
     return mapping;
 }
@@ -1452,7 +1656,12 @@ SDL_PrivateGameControllerAddMapping(const char *mappingString, SDL_ControllerMap
     jGUID = SDL_JoystickGetGUIDFromString(pchGUID);
     SDL_free(pchGUID);
 
-    pControllerMapping = SDL_PrivateAddMappingForGUID(jGUID, mappingString, &existing, priority);
+    /* Only the built-in database is added at the default priority here */
+    if (priority == SDL_CONTROLLER_MAPPING_PRIORITY_DEFAULT) {
+        pControllerMapping = SDL_PrivateAddBuiltinMappingForGUID(jGUID, mappingString, &existing);
+    } else {
+        pControllerMapping = SDL_PrivateAddMappingForGUID(jGUID, mappingString, &existing, priority);
+    }
     if (!pControllerMapping) {
         return -1;
     }
@@ -1513,6 +1722,9 @@ SDL_GameControllerMappingForIndex(int mapping_index)
             char pchGUID[33];
             size_t needed;
 
+            if (!SDL_PrivateLoadMapping(mapping)) {
+                return NULL;
+            }
             SDL_JoystickGetGUIDString(mapping->guid, pchGUID, sizeof(pchGUID));
             /* allocate enough memory for GUID + ',' + name + ',' + mapping + \0 */
             needed = SDL_strlen(pchGUID) + 1 + SDL_strlen(mapping->name) + 1 + SDL_strlen(mapping->mapping) + 1;
@@ -1899,6 +2111,8 @@ SDL_GameControllerOpen(int device_index)
     /* Link the controller in the list */
     gamecontroller->next = SDL_gamecontrollers;
     SDL_gamecontrollers = gamecontroller;
+    gamecontroller->hash_next = SDL_gamecontroller_hash[SDL_GAMECONTROLLER_HASH(instance_id)];
+    SDL_gamecontroller_hash[SDL_GAMECONTROLLER_HASH(instance_id)] = gamecontroller;
 
     SDL_UnlockJoysticks();
 
@@ -2156,6 +2370,13 @@ int SDL_GameControllerSetSensorEnabled(SDL_GameController *gamecontroller, SDL_S
             }
 
             sensor->enabled = enabled;
+            if (!enabled) {
+                /* Don't hand out stale samples once it's turned back on */
+                SDL_LockJoysticks();
+                sensor->sample_head = 0;
+                sensor->sample_count = 0;
+                SDL_UnlockJoysticks();
+            }
             return 0;
         }
     }
@@ -2205,6 +2426,57 @@ SDL_GameControllerGetSensorData(SDL_GameController *gamecontroller, SDL_SensorTy
     return SDL_Unsupported();
 }
 
+/*
+ *  Get the sensor samples queued since the last call.
+ */
+int
+SDL_GameControllerGetSensorDataBatch(SDL_GameController *gamecontroller, SDL_SensorType type, SDL_GameControllerSensorSample *samples, int max_samples)
+{
+    SDL_Joystick *joystick = SDL_GameControllerGetJoystick(gamecontroller);
+    int i, count;
+
+    if (!joystick) {
+        return SDL_InvalidParamError("gamecontroller");
+    }
+    if (!samples && max_samples > 0) {
+        return SDL_InvalidParamError("samples");
+    }
+
+    for (i = 0; i < joystick->nsensors; ++i) {
+        SDL_JoystickSensorInfo *sensor = &joystick->sensors[i];
+
+        if (sensor->type != type) {
+            continue;
+        }
+
+        SDL_LockJoysticks();
+        if (!sensor->samples) {
+            /* Start queueing, there's nothing to return yet */
+            sensor->samples = (SDL_GameControllerSensorSample *)SDL_malloc(SDL_JOYSTICK_SENSOR_SAMPLES * sizeof(*sensor->samples));
+            SDL_UnlockJoysticks();
+            if (!sensor->samples) {
+                return SDL_OutOfMemory();
+            }
+            return 0;
+        }
+
+        count = SDL_min(max_samples, sensor->sample_count);
+        if (count > 0) {
+            /* Copy in at most two pieces, the queue may wrap around */
+            int first = SDL_min(count, SDL_JOYSTICK_SENSOR_SAMPLES - sensor->sample_head);
+            SDL_memcpy(samples, &sensor->samples[sensor->sample_head], first * sizeof(*samples));
+            SDL_memcpy(samples + first, sensor->samples, (count - first) * sizeof(*samples));
+            sensor->sample_head = (sensor->sample_head + count) % SDL_JOYSTICK_SENSOR_SAMPLES;
+            sensor->sample_count -= count;
+        } else {
+            count = 0;
+        }
+        SDL_UnlockJoysticks();
+        return count;
+    }
+    return SDL_Unsupported();
+}
+
 const char *
 SDL_GameControllerName(SDL_GameController *gamecontroller)
 {
@@ -2298,16 +2570,9 @@ SDL_GameControllerFromInstanceID(SDL_JoystickID joyid)
     SDL_GameController *gamecontroller;
 
     SDL_LockJoysticks();
-    gamecontroller = SDL_gamecontrollers;
-    while (gamecontroller) {
-        if (gamecontroller->joystick->instance_id == joyid) {
-            SDL_UnlockJoysticks();
-            return gamecontroller;
-        }
-        gamecontroller = gamecontroller->next;
-    }
+    gamecontroller = SDL_PrivateGameControllerForInstanceID(joyid);
     SDL_UnlockJoysticks();
-    return NULL;
+    return gamecontroller;
 }
 
 
@@ -2433,6 +2698,21 @@ SDL_GameControllerClose(SDL_GameController *gamecontroller)
         return;
     }
 
+    gamecontrollerlist = SDL_gamecontroller_hash[SDL_GAMECONTROLLER_HASH(gamecontroller->joystick->instance_id)];
+    gamecontrollerlistprev = NULL;
+    while (gamecontrollerlist) {
+        if (gamecontroller == gamecontrollerlist) {
+            if (gamecontrollerlistprev) {
+                gamecontrollerlistprev->hash_next = gamecontrollerlist->hash_next;
+            } else {
+                SDL_gamecontroller_hash[SDL_GAMECONTROLLER_HASH(gamecontroller->joystick->instance_id)] = gamecontroller->hash_next;
+            }
+            break;
+        }
+        gamecontrollerlistprev = gamecontrollerlist;
+        gamecontrollerlist = gamecontrollerlist->hash_next;
+    }
+
     SDL_JoystickClose(gamecontroller->joystick);
 
     gamecontrollerlist = SDL_gamecontrollers;
@@ -2454,6 +2734,8 @@ SDL_GameControllerClose(SDL_GameController *gamecontroller)
     SDL_free(gamecontroller->bindings);
     SDL_free(gamecontroller->last_match_axis);
     SDL_free(gamecontroller->last_hat_mask);
+    SDL_free(gamecontroller->input_bindings);
+    SDL_free(gamecontroller->input_start);
     SDL_free(gamecontroller);
 
     SDL_UnlockJoysticks();
@@ -2486,6 +2768,8 @@ SDL_GameControllerQuitMappings(void)
         SDL_free(pControllerMap->mapping);
         SDL_free(pControllerMap);
     }
+    s_pSupportedControllersTail = NULL;
+    SDL_zeroa(s_pMappingHash);
 
     SDL_DelEventWatch(SDL_GameControllerEventWatcher, NULL);
 
@@ -107,12 +107,16 @@ static SDL_JoystickDriver *SDL_joystick_drivers[] = {
 };
 static SDL_bool SDL_joystick_allows_background_events = SDL_FALSE;
 static SDL_Joystick *SDL_joysticks = NULL;
+static SDL_Joystick *SDL_joystick_hash[64];   /* open joysticks by instance ID */
+#define SDL_JOYSTICK_HASH(instance_id) ((Uint32)(instance_id) % SDL_arraysize(SDL_joystick_hash))
 static SDL_bool SDL_updating_joystick = SDL_FALSE;
 static SDL_mutex *SDL_joystick_lock = NULL; /* This needs to support recursive locks */
 static SDL_atomic_t SDL_next_joystick_instance_id;
 static int SDL_joystick_player_count = 0;
 static SDL_JoystickID *SDL_joystick_players = NULL;
 
+static SDL_bool SDL_PrivateJoystickShouldIgnoreEvent(void);
+
 void
 SDL_LockJoysticks(void)
 {
@@ -474,6 +478,8 @@ SDL_JoystickOpen(int device_index)
     /* Link the joystick in the list */
     joystick->next = SDL_joysticks;
     SDL_joysticks = joystick;
+    joystick->hash_next = SDL_joystick_hash[SDL_JOYSTICK_HASH(joystick->instance_id)];
+    SDL_joystick_hash[SDL_JOYSTICK_HASH(joystick->instance_id)] = joystick;
 
     SDL_UnlockJoysticks();
 
@@ -648,19 +654,58 @@ SDL_JoystickNumButtons(SDL_Joystick *joystick)
     return joystick->nbuttons;
 }
 
+/* Returns the input the driver's thread read last, if it has one. While
+   events are ignored for lack of focus, the state the last update sent is
+   used instead, so that the queries keep agreeing with the events. */
+static SDL_JoystickLiveState *
+SDL_GetJoystickLiveState(SDL_Joystick *joystick)
+{
+    if (joystick->live_state && !SDL_PrivateJoystickShouldIgnoreEvent()) {
+        return joystick->live_state;
+    }
+    return NULL;
+}
+
+static void
+SDL_ReadJoystickLiveState(SDL_JoystickLiveState *live, void *dst, const void *src, size_t size)
+{
+    int sequence;
+
+    for (;;) {
+        sequence = SDL_AtomicGet(&live->sequence);
+        if (sequence & 1) {
+            /* The driver is updating it, let it finish */
+            SDL_Delay(0);
+            continue;
+        }
+        SDL_MemoryBarrierAcquire();
+        SDL_memcpy(dst, src, size);
+        SDL_MemoryBarrierAcquire();
+        if (SDL_AtomicGet(&live->sequence) == sequence) {
+            break;
+        }
+    }
+}
+
 /*
  * Get the current state of an axis control on a joystick
  */
 Sint16
 SDL_JoystickGetAxis(SDL_Joystick *joystick, int axis)
 {
+    SDL_JoystickLiveState *live;
     Sint16 state;
 
     if (!SDL_PrivateJoystickValid(joystick)) {
         return 0;
     }
     if (axis < joystick->naxes) {
-        state = joystick->axes[axis].value;
+        live = SDL_GetJoystickLiveState(joystick);
+        if (live) {
+            SDL_ReadJoystickLiveState(live, &state, &live->axes[axis], sizeof(state));
+        } else {
+            state = joystick->axes[axis].value;
+        }
     } else {
         SDL_SetError("Joystick only has %d axes", joystick->naxes);
         state = 0;
@@ -693,13 +738,19 @@ SDL_JoystickGetAxisInitialState(SDL_Joystick *joystick, int axis, Sint16 *state)
 Uint8
 SDL_JoystickGetHat(SDL_Joystick *joystick, int hat)
 {
+    SDL_JoystickLiveState *live;
     Uint8 state;
 
     if (!SDL_PrivateJoystickValid(joystick)) {
         return 0;
     }
     if (hat < joystick->nhats) {
-        state = joystick->hats[hat];
+        live = SDL_GetJoystickLiveState(joystick);
+        if (live) {
+            SDL_ReadJoystickLiveState(live, &state, &live->hats[hat], sizeof(state));
+        } else {
+            state = joystick->hats[hat];
+        }
     } else {
         SDL_SetError("Joystick only has %d hats", joystick->nhats);
         state = 0;
@@ -741,13 +792,19 @@ SDL_JoystickGetBall(SDL_Joystick *joystick, int ball, int *dx, int *dy)
 Uint8
 SDL_JoystickGetButton(SDL_Joystick *joystick, int button)
 {
+    SDL_JoystickLiveState *live;
     Uint8 state;
 
     if (!SDL_PrivateJoystickValid(joystick)) {
         return 0;
     }
     if (button < joystick->nbuttons) {
-        state = joystick->buttons[button];
+        live = SDL_GetJoystickLiveState(joystick);
+        if (live) {
+            SDL_ReadJoystickLiveState(live, &state, &live->buttons[button], sizeof(state));
+        } else {
+            state = joystick->buttons[button];
+        }
     } else {
         SDL_SetError("Joystick only has %d buttons", joystick->nbuttons);
         state = 0;
@@ -755,6 +812,27 @@ SDL_JoystickGetButton(SDL_Joystick *joystick, int button)
     return state;
 }
 
+/*
+ * Get the time the state of a joystick was read
+ */
+Uint64
+SDL_JoystickGetStateTimestamp(SDL_Joystick *joystick)
+{
+    SDL_JoystickLiveState *live;
+    Uint64 timestamp;
+
+    if (!SDL_PrivateJoystickValid(joystick)) {
+        return 0;
+    }
+    live = SDL_GetJoystickLiveState(joystick);
+    if (live) {
+        SDL_ReadJoystickLiveState(live, &timestamp, &live->timestamp, sizeof(timestamp));
+    } else {
+        timestamp = joystick->timestamp;
+    }
+    return timestamp;
+}
+
 /*
  * Return if the joystick in question is currently attached to the system,
  *  \return SDL_FALSE if not plugged in, SDL_TRUE if still present.
@@ -791,7 +869,7 @@ SDL_JoystickFromInstanceID(SDL_JoystickID instance_id)
     SDL_Joystick *joystick;
 
     SDL_LockJoysticks();
-    for (joystick = SDL_joysticks; joystick; joystick = joystick->next) {
+    for (joystick = SDL_joystick_hash[SDL_JOYSTICK_HASH(instance_id)]; joystick; joystick = joystick->hash_next) {
         if (joystick->instance_id == instance_id) {
             break;
         }
@@ -1060,6 +1138,21 @@ SDL_JoystickClose(SDL_Joystick *joystick)
         joysticklist = joysticklist->next;
     }
 
+    joysticklist = SDL_joystick_hash[SDL_JOYSTICK_HASH(joystick->instance_id)];
+    joysticklistprev = NULL;
+    while (joysticklist) {
+        if (joystick == joysticklist) {
+            if (joysticklistprev) {
+                joysticklistprev->hash_next = joysticklist->hash_next;
+            } else {
+                SDL_joystick_hash[SDL_JOYSTICK_HASH(joystick->instance_id)] = joystick->hash_next;
+            }
+            break;
+        }
+        joysticklistprev = joysticklist;
+        joysticklist = joysticklist->hash_next;
+    }
+
     SDL_free(joystick->name);
     SDL_free(joystick->serial);
 
@@ -1073,6 +1166,9 @@ SDL_JoystickClose(SDL_Joystick *joystick)
         SDL_free(touchpad->fingers);
     }
     SDL_free(joystick->touchpads);
+    for (i = 0; i < joystick->nsensors; i++) {
+        SDL_free(joystick->sensors[i].samples);
+    }
     SDL_free(joystick->sensors);
     SDL_free(joystick);
 
@@ -1374,6 +1470,7 @@ SDL_PrivateJoystickAxis(SDL_Joystick *joystick, Uint8 axis, Sint16 value)
 
     /* Update internal joystick state */
     info->value = value;
+    joystick->timestamp = SDL_GetPerformanceCounter();
 
     /* Post the event, if desired */
     posted = 0;
@@ -1414,6 +1511,7 @@ SDL_PrivateJoystickHat(SDL_Joystick *joystick, Uint8 hat, Uint8 value)
 
     /* Update internal joystick state */
     joystick->hats[hat] = value;
+    joystick->timestamp = SDL_GetPerformanceCounter();
 
     /* Post the event, if desired */
     posted = 0;
@@ -1504,6 +1602,7 @@ SDL_PrivateJoystickButton(SDL_Joystick *joystick, Uint8 button, Uint8 state)
 
     /* Update internal joystick state */
     joystick->buttons[button] = state;
+    joystick->timestamp = SDL_GetPerformanceCounter();
 
     /* Post the event, if desired */
     posted = 0;
@@ -2694,6 +2793,25 @@ int SDL_PrivateJoystickSensor(SDL_Joystick *joystick, SDL_SensorType type, const
         if (sensor->type == type) {
             if (sensor->enabled) {
                 num_values = SDL_min(num_values, SDL_arraysize(sensor->data));
+
+                /* Queue every sample, repeated values are still readings */
+                if (sensor->samples) {
+                    SDL_GameControllerSensorSample *sample;
+
+                    SDL_LockJoysticks();
+                    if (sensor->sample_count == SDL_JOYSTICK_SENSOR_SAMPLES) {
+                        /* Drop the oldest sample */
+                        sensor->sample_head = (sensor->sample_head + 1) % SDL_JOYSTICK_SENSOR_SAMPLES;
+                        --sensor->sample_count;
+                    }
+                    sample = &sensor->samples[(sensor->sample_head + sensor->sample_count) % SDL_JOYSTICK_SENSOR_SAMPLES];
+                    sample->timestamp = SDL_GetPerformanceCounter();
+                    SDL_zeroa(sample->data);
+                    SDL_memcpy(sample->data, data, num_values*sizeof(*data));
+                    ++sensor->sample_count;
+                    SDL_UnlockJoysticks();
+                }
+
                 if (SDL_memcmp(data, sensor->data, num_values*sizeof(*data)) != 0) {
 
                     /* Update internal sensor state */
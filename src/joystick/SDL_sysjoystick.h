@@ -24,7 +24,9 @@
 #define SDL_sysjoystick_h_
 
 /* This is the system specific header for the SDL joystick API */
+#include "SDL_atomic.h"
 #include "SDL_joystick.h"
+#include "SDL_gamecontroller.h"
 #include "SDL_joystick_c.h"
 
 /* The SDL joystick structure */
@@ -57,8 +59,29 @@ typedef struct _SDL_JoystickSensorInfo
     SDL_SensorType type;
     SDL_bool enabled;
     float data[3];      /* If this needs to expand, update SDL_ControllerSensorEvent */
+
+    /* Queued samples for SDL_GameControllerGetSensorDataBatch(), allocated on first use */
+    SDL_GameControllerSensorSample *samples;
+    int sample_head;
+    int sample_count;
 } SDL_JoystickSensorInfo;
 
+/* The number of sensor samples queued before the oldest are dropped */
+#define SDL_JOYSTICK_SENSOR_SAMPLES 256
+
+/* The latest input of a joystick whose driver reads it on a thread of its
+   own, so the state queries don't have to wait for SDL_JoystickUpdate().
+   The driver makes the sequence number odd while it updates the state, and
+   readers retry if it was odd or changed while they were reading. */
+typedef struct _SDL_JoystickLiveState
+{
+    SDL_atomic_t sequence;
+    Uint64 timestamp;           /* SDL_GetPerformanceCounter() when the input was read */
+    Sint16 *axes;
+    Uint8 *buttons;
+    Uint8 *hats;
+} SDL_JoystickLiveState;
+
 struct _SDL_Joystick
 {
     SDL_JoystickID instance_id; /* Device instance, monotonically increasing from 0 */
@@ -81,6 +104,9 @@ struct _SDL_Joystick
     int nbuttons;               /* Number of buttons on the joystick */
     Uint8 *buttons;             /* Current button states */
 
+    Uint64 timestamp;           /* SDL_GetPerformanceCounter() when the state last changed */
+    SDL_JoystickLiveState *live_state;  /* Set while the driver reads input on its own thread */
+
     int ntouchpads;             /* Number of touchpads on the joystick */
     SDL_JoystickTouchpadInfo *touchpads;    /* Current touchpad states */
 
@@ -113,6 +139,7 @@ struct _SDL_Joystick
     int ref_count;              /* Reference count for multiple opens */
 
     struct _SDL_Joystick *next; /* pointer to next joystick we have allocated */
+    struct _SDL_Joystick *hash_next; /* next joystick in the same instance ID hash bucket */
 };
 
 /* Device bus definitions */
@@ -420,7 +420,7 @@ HIDAPI_DriverPS4_TickleBluetooth(SDL_HIDAPI_Device *device)
     data[0] = k_EPS4ReportIdBluetoothEffects;
     data[1] = 0xC0;  /* Magic value HID + CRC */
 
-    SDL_HIDAPI_SendRumble(device, data, sizeof(data));
+    SDL_HIDAPI_SendOutputReport(device, SDL_HIDAPI_REPORT_GENERAL, data, sizeof(data));
 }
 
 static void
@@ -476,7 +476,7 @@ HIDAPI_DriverPS5_TickleBluetooth(SDL_HIDAPI_Device *device)
     data[0] = k_EPS5ReportIdBluetoothEffects;
     data[1] = 0x02;  /* Magic value */
 
-    SDL_HIDAPI_SendRumble(device, data, sizeof(data));
+    SDL_HIDAPI_SendOutputReport(device, SDL_HIDAPI_REPORT_GENERAL, data, sizeof(data));
 }
 
 static void
@@ -727,7 +727,7 @@ HIDAPI_DriverPS5_SendJoystickEffect(SDL_HIDAPI_Device *device, SDL_Joystick *joy
     }
 
     /* See if we can update an existing pending request */
-    if (SDL_HIDAPI_GetPendingRumbleLocked(device, &pending_data, &pending_size, &maximum_size)) {
+    if (SDL_HIDAPI_GetPendingRumbleLocked(device, SDL_HIDAPI_REPORT_RUMBLE, &pending_data, &pending_size, &maximum_size)) {
         DS5EffectsState_t *effects = (DS5EffectsState_t *)&data[offset];
         DS5EffectsState_t *pending_effects = (DS5EffectsState_t *)&pending_data[offset];
         if (report_size == *pending_size &&
@@ -740,7 +740,7 @@ HIDAPI_DriverPS5_SendJoystickEffect(SDL_HIDAPI_Device *device, SDL_Joystick *joy
         }
     }
 
-    return SDL_HIDAPI_SendRumbleAndUnlock(device, data, report_size);
+    return SDL_HIDAPI_SendRumbleAndUnlock(device, SDL_HIDAPI_REPORT_RUMBLE, data, report_size);
 }
 
 static int
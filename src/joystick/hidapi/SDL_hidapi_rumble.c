@@ -22,7 +22,13 @@
 
 #ifdef SDL_JOYSTICK_HIDAPI
 
-/* Handle rumble on a separate thread so it doesn't block the application */
+/* Handle rumble on a separate thread so it doesn't block the application
+
+   Reports are written in the order they were queued, but each device gets at
+   most one report every SDL_HIDAPI_RUMBLE_INTERVAL milliseconds, so we don't
+   starve report reads when there's lots of rumble. A device that is waiting
+   for its next slot doesn't hold up reports for other devices.
+ */
 
 #include "SDL_thread.h"
 #include "SDL_timer.h"
@@ -30,10 +36,13 @@
 #include "SDL_hidapi_rumble.h"
 #include "../../thread/SDL_systhread.h"
 
+#define SDL_HIDAPI_RUMBLE_INTERVAL  10
+
 
 typedef struct SDL_HIDAPI_RumbleRequest
 {
     SDL_HIDAPI_Device *device;
+    SDL_HIDAPI_ReportType type;
     Uint8 data[2*USB_PACKET_LENGTH]; /* need enough space for the biggest report: dualshock4 is 78 bytes */
     int size;
     struct SDL_HIDAPI_RumbleRequest *prev;
@@ -53,6 +62,38 @@ typedef struct SDL_HIDAPI_RumbleContext
 
 static SDL_HIDAPI_RumbleContext rumble_context;
 
+/* Removes and returns the oldest request for a device that is ready for another report.
+   If there isn't one, timeout is set to the time until the next device is ready.
+ */
+static SDL_HIDAPI_RumbleRequest *
+SDL_HIDAPI_TakeReadyRequestLocked(SDL_HIDAPI_RumbleContext *ctx, Uint32 now, Uint32 *timeout)
+{
+    SDL_HIDAPI_RumbleRequest *request, *older = NULL;
+
+    *timeout = SDL_MUTEX_MAXWAIT;
+
+    for (request = ctx->requests_tail; request; older = request, request = request->prev) {
+        /* Anything more than an interval away is left over from a tick count wraparound */
+        Sint32 remaining = (Sint32)(request->device->next_output_report - now);
+        if (remaining <= 0 || remaining > SDL_HIDAPI_RUMBLE_INTERVAL) {
+            break;
+        }
+        *timeout = SDL_min(*timeout, (Uint32)remaining);
+    }
+
+    if (request) {
+        if (older) {
+            older->prev = request->prev;
+        } else {
+            ctx->requests_tail = request->prev;
+        }
+        if (request == ctx->requests_head) {
+            ctx->requests_head = older;
+        }
+    }
+    return request;
+}
+
 static int SDL_HIDAPI_RumbleThread(void *data)
 {
     SDL_HIDAPI_RumbleContext *ctx = (SDL_HIDAPI_RumbleContext *)data;
@@ -61,34 +102,32 @@ static int SDL_HIDAPI_RumbleThread(void *data)
 
     while (SDL_AtomicGet(&ctx->running)) {
         SDL_HIDAPI_RumbleRequest *request = NULL;
-
-        SDL_SemWait(ctx->request_sem);
+        SDL_HIDAPI_Device *device;
+        Uint32 timeout;
 
         SDL_LockMutex(ctx->lock);
-        request = ctx->requests_tail;
-        if (request) {
-            if (request == ctx->requests_head) {
-                ctx->requests_head = NULL;
-            }
-            ctx->requests_tail = request->prev;
-        }
+        request = SDL_HIDAPI_TakeReadyRequestLocked(ctx, SDL_GetTicks(), &timeout);
         SDL_UnlockMutex(ctx->lock);
 
-        if (request) {
-            SDL_LockMutex(request->device->dev_lock);
-            if (request->device->dev) {
+        if (!request) {
+            SDL_SemWaitTimeout(ctx->request_sem, timeout);
+            continue;
+        }
+
+        device = request->device;
+        SDL_LockMutex(device->dev_lock);
+        if (device->dev) {
 #ifdef DEBUG_RUMBLE
-                HIDAPI_DumpPacket("Rumble packet: size = %d", request->data, request->size);
+            HIDAPI_DumpPacket("Rumble packet: size = %d", request->data, request->size);
 #endif
-                hid_write(request->device->dev, request->data, request->size);
-            }
-            SDL_UnlockMutex(request->device->dev_lock);
-            (void)SDL_AtomicDecRef(&request->device->rumble_pending);
-            SDL_free(request);
-
-            /* Make sure we're not starving report reads when there's lots of rumble */
-            SDL_Delay(10);
+            hid_write(device->dev, request->data, request->size);
         }
+        SDL_UnlockMutex(device->dev_lock);
+
+        /* The device may be freed as soon as it has no pending requests */
+        device->next_output_report = SDL_GetTicks() + SDL_HIDAPI_RUMBLE_INTERVAL;
+        (void)SDL_AtomicDecRef(&device->rumble_pending);
+        SDL_free(request);
     }
     return 0;
 }
@@ -171,14 +210,18 @@ int SDL_HIDAPI_LockRumble(void)
     return SDL_LockMutex(ctx->lock);
 }
 
-SDL_bool SDL_HIDAPI_GetPendingRumbleLocked(SDL_HIDAPI_Device *device, Uint8 **data, int **size, int *maximum_size)
+SDL_bool SDL_HIDAPI_GetPendingRumbleLocked(SDL_HIDAPI_Device *device, SDL_HIDAPI_ReportType type, Uint8 **data, int **size, int *maximum_size)
 {
     SDL_HIDAPI_RumbleContext *ctx = &rumble_context;
     SDL_HIDAPI_RumbleRequest *request, *found;
 
+    if (type == SDL_HIDAPI_REPORT_GENERAL) {
+        return SDL_FALSE;
+    }
+
     found = NULL;
     for (request = ctx->requests_tail; request; request = request->prev) {
-        if (request->device == device) {
+        if (request->device == device && request->type == type) {
             found = request;
         }
     }
@@ -191,7 +234,7 @@ SDL_bool SDL_HIDAPI_GetPendingRumbleLocked(SDL_HIDAPI_Device *device, Uint8 **da
     return SDL_FALSE;
 }
 
-int SDL_HIDAPI_SendRumbleAndUnlock(SDL_HIDAPI_Device *device, const Uint8 *data, int size)
+int SDL_HIDAPI_SendRumbleAndUnlock(SDL_HIDAPI_Device *device, SDL_HIDAPI_ReportType type, const Uint8 *data, int size)
 {
     SDL_HIDAPI_RumbleContext *ctx = &rumble_context;
     SDL_HIDAPI_RumbleRequest *request;
@@ -207,6 +250,7 @@ int SDL_HIDAPI_SendRumbleAndUnlock(SDL_HIDAPI_Device *device, const Uint8 *data,
         return SDL_OutOfMemory();
     }
     request->device = device;
+    request->type = type;
     SDL_memcpy(request->data, data, size);
     request->size = size;
 
@@ -234,7 +278,7 @@ void SDL_HIDAPI_UnlockRumble(void)
     SDL_UnlockMutex(ctx->lock);
 }
 
-int SDL_HIDAPI_SendRumble(SDL_HIDAPI_Device *device, const Uint8 *data, int size)
+int SDL_HIDAPI_SendOutputReport(SDL_HIDAPI_Device *device, SDL_HIDAPI_ReportType type, const Uint8 *data, int size)
 {
     Uint8 *pending_data;
     int *pending_size;
@@ -244,8 +288,8 @@ int SDL_HIDAPI_SendRumble(SDL_HIDAPI_Device *device, const Uint8 *data, int size
         return -1;
     }
 
-    /* check if there is a pending request for the device and update it */
-    if (SDL_HIDAPI_GetPendingRumbleLocked(device, &pending_data, &pending_size, &maximum_size)) {
+    /* check if there is a pending request of this type for the device and update it */
+    if (SDL_HIDAPI_GetPendingRumbleLocked(device, type, &pending_data, &pending_size, &maximum_size)) {
         if (size > maximum_size) {
             SDL_HIDAPI_UnlockRumble();
             return SDL_SetError("Couldn't send rumble, size %d is greater than %d", size, maximum_size);
@@ -257,7 +301,12 @@ int SDL_HIDAPI_SendRumble(SDL_HIDAPI_Device *device, const Uint8 *data, int size
         return size;
     }
 
-    return SDL_HIDAPI_SendRumbleAndUnlock(device, data, size);
+    return SDL_HIDAPI_SendRumbleAndUnlock(device, type, data, size);
+}
+
+int SDL_HIDAPI_SendRumble(SDL_HIDAPI_Device *device, const Uint8 *data, int size)
+{
+    return SDL_HIDAPI_SendOutputReport(device, SDL_HIDAPI_REPORT_RUMBLE, data, size);
 }
 
 void SDL_HIDAPI_QuitRumble(void)
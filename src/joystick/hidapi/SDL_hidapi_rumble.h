@@ -22,15 +22,27 @@
 
 #ifdef SDL_JOYSTICK_HIDAPI
 
-/* Handle rumble on a separate thread so it doesn't block the application */
+/* Handle rumble and other output reports on a separate thread so it doesn't block the application */
+
+/* Each pending report has a type, and a new report replaces a pending report
+   of the same type for the same device. General reports are always sent in
+   the order they were queued and are never replaced.
+ */
+typedef enum
+{
+    SDL_HIDAPI_REPORT_GENERAL,
+    SDL_HIDAPI_REPORT_RUMBLE,   /* rumble, or the complete effects state for controllers that send it all at once */
+    SDL_HIDAPI_REPORT_LED
+} SDL_HIDAPI_ReportType;
 
 /* Advanced API */
 int SDL_HIDAPI_LockRumble(void);
-SDL_bool SDL_HIDAPI_GetPendingRumbleLocked(SDL_HIDAPI_Device *device, Uint8 **data, int **size, int *maximum_size);
-int SDL_HIDAPI_SendRumbleAndUnlock(SDL_HIDAPI_Device *device, const Uint8 *data, int size);
+SDL_bool SDL_HIDAPI_GetPendingRumbleLocked(SDL_HIDAPI_Device *device, SDL_HIDAPI_ReportType type, Uint8 **data, int **size, int *maximum_size);
+int SDL_HIDAPI_SendRumbleAndUnlock(SDL_HIDAPI_Device *device, SDL_HIDAPI_ReportType type, const Uint8 *data, int size);
 void SDL_HIDAPI_UnlockRumble(void);
 
-/* Simple API, will replace any pending rumble with the new data */
+/* Simple API, will replace any pending report of the same type with the new data */
+int SDL_HIDAPI_SendOutputReport(SDL_HIDAPI_Device *device, SDL_HIDAPI_ReportType type, const Uint8 *data, int size);
 int SDL_HIDAPI_SendRumble(SDL_HIDAPI_Device *device, const Uint8 *data, int size);
 void SDL_HIDAPI_QuitRumble(void);
 
@@ -354,7 +354,7 @@ static int WriteOutput(SDL_DriverSwitch_Context *ctx, const Uint8 *data, int siz
     if (SDL_HIDAPI_LockRumble() < 0) {
         return -1;
     }
-    return SDL_HIDAPI_SendRumbleAndUnlock(ctx->device, data, size);
+    return SDL_HIDAPI_SendRumbleAndUnlock(ctx->device, SDL_HIDAPI_REPORT_GENERAL, data, size);
 #endif /* SWITCH_SYNCHRONOUS_WRITES */
 }
 
@@ -88,14 +88,14 @@ HIDAPI_DriverXbox360_GetDeviceName(Uint16 vendor_id, Uint16 product_id)
     return NULL;
 }
 
-static SDL_bool SetSlotLED(hid_device *dev, Uint8 slot)
+static SDL_bool SetSlotLED(SDL_HIDAPI_Device *device, Uint8 slot)
 {
     const SDL_bool blink = SDL_FALSE;
     Uint8 mode = (blink ? 0x02 : 0x06) + slot;
     Uint8 led_packet[] = { 0x01, 0x03, 0x00 };
 
     led_packet[2] = mode;
-    if (hid_write(dev, led_packet, sizeof(led_packet)) != sizeof(led_packet)) {
+    if (SDL_HIDAPI_SendOutputReport(device, SDL_HIDAPI_REPORT_LED, led_packet, sizeof(led_packet)) != sizeof(led_packet)) {
         return SDL_FALSE;
     }
     return SDL_TRUE;
@@ -120,7 +120,7 @@ HIDAPI_DriverXbox360_SetDevicePlayerIndex(SDL_HIDAPI_Device *device, SDL_Joystic
         return;
     }
     if (player_index >= 0) {
-        SetSlotLED(device->dev, (player_index % 4));
+        SetSlotLED(device, (player_index % 4));
     }
 }
 
@@ -147,7 +147,7 @@ HIDAPI_DriverXbox360_OpenJoystick(SDL_HIDAPI_Device *device, SDL_Joystick *joyst
     /* Set the controller LED */
     player_index = SDL_JoystickGetPlayerIndex(joystick);
     if (player_index >= 0) {
-        SetSlotLED(device->dev, (player_index % 4));
+        SetSlotLED(device, (player_index % 4));
     }
 
     /* Initialize the joystick capabilities */
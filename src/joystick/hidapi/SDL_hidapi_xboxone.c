@@ -197,7 +197,7 @@ SendSerialRequest(SDL_HIDAPI_Device *device, SDL_DriverXboxOne_Context *ctx)
      * ignored if sent during the negotiation.
      */
     if (SDL_HIDAPI_LockRumble() < 0 ||
-        SDL_HIDAPI_SendRumbleAndUnlock(device, serial_packet, sizeof(serial_packet)) != sizeof(serial_packet)) {
+        SDL_HIDAPI_SendRumbleAndUnlock(device, SDL_HIDAPI_REPORT_GENERAL, serial_packet, sizeof(serial_packet)) != sizeof(serial_packet)) {
         SDL_SetError("Couldn't send serial packet");
         return SDL_FALSE;
     }
@@ -251,7 +251,7 @@ SendControllerInit(SDL_HIDAPI_Device *device, SDL_DriverXboxOne_Context *ctx)
         ctx->send_time = SDL_GetTicks();
 
         if (SDL_HIDAPI_LockRumble() < 0 ||
-            SDL_HIDAPI_SendRumbleAndUnlock(device, init_packet, packet->size) != packet->size) {
+            SDL_HIDAPI_SendRumbleAndUnlock(device, SDL_HIDAPI_REPORT_GENERAL, init_packet, packet->size) != packet->size) {
             SDL_SetError("Couldn't write Xbox One initialization packet");
             return SDL_FALSE;
         }
@@ -110,6 +110,7 @@ static SDL_HIDAPI_DeviceDriver *SDL_HIDAPI_drivers[] = {
 static int SDL_HIDAPI_numdrivers = 0;
 static SDL_SpinLock SDL_HIDAPI_spinlock;
 static SDL_HIDAPI_Device *SDL_HIDAPI_devices;
+static SDL_HIDAPI_Device *SDL_HIDAPI_device_hash[64];
 static int SDL_HIDAPI_numjoysticks = 0;
 static SDL_bool initialized = SDL_FALSE;
 static SDL_bool shutting_down = SDL_FALSE;
@@ -128,6 +129,10 @@ static struct
     SDL_bool m_bCanGetNotifications;
     Uint32 m_unLastDetect;
 
+    /* Vendors that need to be rescanned, when we know which devices changed */
+    int m_nPendingVendors;
+    Uint16 m_unPendingVendors[8];
+
 #if defined(__WIN32__)
     SDL_threadID m_nThreadID;
     WNDCLASSEXA m_wndClass;
@@ -250,12 +255,99 @@ StrIsInteger(const char *string)
 }
 #endif
 
+static Uint32
+HIDAPI_GetDeviceHashBucket(const char *path)
+{
+    /* FNV-1a */
+    Uint32 hash = 2166136261u;
+
+    while (*path) {
+        hash ^= (Uint8)*path++;
+        hash *= 16777619u;
+    }
+    return hash % SDL_arraysize(SDL_HIDAPI_device_hash);
+}
+
+static SDL_HIDAPI_Device *
+HIDAPI_GetDeviceByPath(const char *path)
+{
+    SDL_HIDAPI_Device *device;
+
+    for (device = SDL_HIDAPI_device_hash[HIDAPI_GetDeviceHashBucket(path)]; device; device = device->hash_next) {
+        if (SDL_strcmp(device->path, path) == 0) {
+            break;
+        }
+    }
+    return device;
+}
+
+#if defined(SDL_USE_LIBUDEV) || defined(HAVE_INOTIFY)
+static void
+HIDAPI_AddPendingVendor(Uint16 vendor_id)
+{
+    int i;
+
+    if (SDL_HIDAPI_discovery.m_bHaveDevicesChanged) {
+        /* We're going to rescan everything anyway */
+        return;
+    }
+
+    for (i = 0; i < SDL_HIDAPI_discovery.m_nPendingVendors; ++i) {
+        if (SDL_HIDAPI_discovery.m_unPendingVendors[i] == vendor_id) {
+            return;
+        }
+    }
+    if (vendor_id == 0 || i == SDL_arraysize(SDL_HIDAPI_discovery.m_unPendingVendors)) {
+        SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_TRUE;
+        return;
+    }
+    SDL_HIDAPI_discovery.m_unPendingVendors[SDL_HIDAPI_discovery.m_nPendingVendors++] = vendor_id;
+}
+
+/* Called when a hidraw node, e.g. "hidraw3", shows up or becomes readable */
+static void
+HIDAPI_HIDRawAdded(const char *node)
+{
+    char path[128];
+    char *uevent, *hid_id;
+
+    /* The HID_ID of the parent device is "bus:vendor:product" in hex */
+    SDL_snprintf(path, sizeof(path), "/sys/class/hidraw/%s/device/uevent", node);
+    uevent = (char *)SDL_LoadFile(path, NULL);
+    hid_id = uevent ? SDL_strstr(uevent, "HID_ID=") : NULL;
+    if (hid_id && (hid_id = SDL_strchr(hid_id, ':')) != NULL) {
+        HIDAPI_AddPendingVendor((Uint16)SDL_strtoul(hid_id + 1, NULL, 16));
+    } else {
+        SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_TRUE;
+    }
+    SDL_free(uevent);
+}
+
+/* Called when a hidraw node goes away, its sysfs entry is already gone */
+static void
+HIDAPI_HIDRawRemoved(const char *node)
+{
+    char path[128];
+    SDL_HIDAPI_Device *device;
+
+    SDL_snprintf(path, sizeof(path), "/dev/%s", node);
+
+    SDL_LockJoysticks();
+    device = HIDAPI_GetDeviceByPath(path);
+    if (device) {
+        HIDAPI_AddPendingVendor(device->vendor_id);
+    }
+    SDL_UnlockJoysticks();
+}
+#endif /* SDL_USE_LIBUDEV || HAVE_INOTIFY */
+
 static void
 HIDAPI_InitializeDiscovery()
 {
     SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_TRUE;
     SDL_HIDAPI_discovery.m_bCanGetNotifications = SDL_FALSE;
     SDL_HIDAPI_discovery.m_unLastDetect = 0;
+    SDL_HIDAPI_discovery.m_nPendingVendors = 0;
 
 #if defined(__WIN32__)
     SDL_HIDAPI_discovery.m_nThreadID = SDL_ThreadID();
@@ -431,9 +523,8 @@ HIDAPI_UpdateDiscovery()
     if (linux_enumeration_method == ENUMERATION_LIBUDEV) {
         if (SDL_HIDAPI_discovery.m_nUdevFd >= 0) {
             /* Drain all notification events.
-             * We don't expect a lot of device notifications so just
-             * do a new discovery on any kind or number of notifications.
-             * This could be made more restrictive if necessary.
+             * Only hidraw nodes (and USB devices, if libusb is in use) are
+             * interesting, and we only rescan the vendors that changed.
              */
             for (;;) {
                 struct pollfd PollUdev;
@@ -447,10 +538,31 @@ HIDAPI_UpdateDiscovery()
 
                 pUdevDevice = usyms->udev_monitor_receive_device(SDL_HIDAPI_discovery.m_pUdevMonitor);
                 if (pUdevDevice) {
-                    const char *action = NULL;
-                    action = usyms->udev_device_get_action(pUdevDevice);
-                    if (!action || SDL_strcmp(action, "add") == 0 || SDL_strcmp(action, "remove") == 0) {
+                    const char *action = usyms->udev_device_get_action(pUdevDevice);
+                    const char *subsystem = usyms->udev_device_get_subsystem(pUdevDevice);
+                    const char *devnode = usyms->udev_device_get_devnode(pUdevDevice);
+                    const char *node = devnode ? SDL_strrchr(devnode, '/') : NULL;
+
+                    if (!action || !subsystem) {
                         SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_TRUE;
+                    } else if (SDL_strcmp(subsystem, "hidraw") == 0 && node) {
+                        if (SDL_strcmp(action, "add") == 0) {
+                            HIDAPI_HIDRawAdded(node + 1);
+                        } else if (SDL_strcmp(action, "remove") == 0) {
+                            HIDAPI_HIDRawRemoved(node + 1);
+                        }
+#ifdef SDL_LIBUSB_DYNAMIC
+                    } else if (SDL_strcmp(subsystem, "usb") == 0 &&
+                               (SDL_strcmp(action, "add") == 0 || SDL_strcmp(action, "remove") == 0)) {
+                        /* Devices opened through libusb may not have a hidraw node,
+                           PRODUCT is "vendor/product/version" in hex */
+                        const char *product = usyms->udev_device_get_property_value(pUdevDevice, "PRODUCT");
+                        if (product) {
+                            HIDAPI_AddPendingVendor((Uint16)SDL_strtoul(product, NULL, 16));
+                        } else {
+                            SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_TRUE;
+                        }
+#endif
                     }
                     usyms->udev_device_unref(pUdevDevice);
                 }
@@ -483,10 +595,14 @@ HIDAPI_UpdateDiscovery()
                     !SDL_HIDAPI_discovery.m_bHaveDevicesChanged) {
                     if (StrHasPrefix(buf.event.name, "hidraw") &&
                         StrIsInteger(buf.event.name + strlen ("hidraw"))) {
-                        SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_TRUE;
                         /* We found an hidraw change. We still continue to
                          * drain the inotify fd to avoid leaving old
                          * notifications in the queue. */
+                        if (buf.event.mask & (IN_CREATE | IN_MOVED_TO | IN_ATTRIB)) {
+                            HIDAPI_HIDRawAdded(buf.event.name);
+                        } else if (buf.event.mask & (IN_DELETE | IN_MOVED_FROM)) {
+                            HIDAPI_HIDRawRemoved(buf.event.name);
+                        }
                     }
                 }
 
@@ -643,13 +759,9 @@ HIDAPI_GetDeviceByIndex(int device_index, SDL_JoystickID *pJoystickID)
 static SDL_HIDAPI_Device *
 HIDAPI_GetJoystickByInfo(const char *path, Uint16 vendor_id, Uint16 product_id)
 {
-    SDL_HIDAPI_Device *device = SDL_HIDAPI_devices;
-    while (device) {
-        if (device->vendor_id == vendor_id && device->product_id == product_id &&
-            SDL_strcmp(device->path, path) == 0) {
-            break;
-        }
-        device = device->next;
+    SDL_HIDAPI_Device *device = HIDAPI_GetDeviceByPath(path);
+    if (device && (device->vendor_id != vendor_id || device->product_id != product_id)) {
+        device = NULL;
     }
     return device;
 }
@@ -991,6 +1103,11 @@ HIDAPI_AddDevice(struct hid_device_info *info)
     } else {
         SDL_HIDAPI_devices = device;
     }
+    {
+        Uint32 bucket = HIDAPI_GetDeviceHashBucket(device->path);
+        device->hash_next = SDL_HIDAPI_device_hash[bucket];
+        SDL_HIDAPI_device_hash[bucket] = device;
+    }
 
     HIDAPI_SetupDeviceDriver(device);
 
@@ -1011,11 +1128,19 @@ HIDAPI_DelDevice(SDL_HIDAPI_Device *device)
 
     for (curr = SDL_HIDAPI_devices, last = NULL; curr; last = curr, curr = curr->next) {
         if (curr == device) {
+            SDL_HIDAPI_Device **link;
+
             if (last) {
                 last->next = curr->next;
             } else {
                 SDL_HIDAPI_devices = curr->next;
             }
+            for (link = &SDL_HIDAPI_device_hash[HIDAPI_GetDeviceHashBucket(device->path)]; *link; link = &(*link)->hash_next) {
+                if (*link == device) {
+                    *link = device->hash_next;
+                    break;
+                }
+            }
 
             HIDAPI_CleanupDeviceDriver(device);
 
@@ -1034,8 +1159,9 @@ HIDAPI_DelDevice(SDL_HIDAPI_Device *device)
     }
 }
 
+/* Rescan the devices from one vendor, or all devices if vendor_id is 0 */
 static void
-HIDAPI_UpdateDeviceList(void)
+HIDAPI_UpdateDeviceList(Uint16 vendor_id)
 {
     SDL_HIDAPI_Device *device;
     struct hid_device_info *devs, *info;
@@ -1045,13 +1171,15 @@ HIDAPI_UpdateDeviceList(void)
     /* Prepare the existing device list */
     device = SDL_HIDAPI_devices;
     while (device) {
-        device->seen = SDL_FALSE;
+        if (!vendor_id || device->vendor_id == vendor_id) {
+            device->seen = SDL_FALSE;
+        }
         device = device->next;
     }
 
     /* Enumerate the devices */
     if (SDL_HIDAPI_numdrivers > 0) {
-        devs = hid_enumerate(0, 0);
+        devs = hid_enumerate(vendor_id, 0);
         if (devs) {
             for (info = devs; info; info = info->next) {
                 device = HIDAPI_GetJoystickByInfo(info->path, info->vendor_id, info->product_id);
@@ -1137,7 +1265,15 @@ HIDAPI_IsDevicePresent(Uint16 vendor_id, Uint16 product_id, Uint16 version, cons
 #endif /* SDL_JOYSTICK_HIDAPI_XBOX360 || SDL_JOYSTICK_HIDAPI_XBOXONE */
     if (supported) {
         if (SDL_AtomicTryLock(&SDL_HIDAPI_spinlock)) {
-            HIDAPI_UpdateDeviceList();
+            /* Only devices from the same vendor can match, except for the
+               made up Xbox product IDs, which match any Xbox controller */
+            if (vendor_id == USB_VENDOR_MICROSOFT &&
+                (product_id == USB_PRODUCT_XBOX_ONE_XBOXGIP_CONTROLLER ||
+                 product_id == USB_PRODUCT_XBOX_ONE_XINPUT_CONTROLLER)) {
+                HIDAPI_UpdateDeviceList(0);
+            } else {
+                HIDAPI_UpdateDeviceList(vendor_id);
+            }
             SDL_AtomicUnlock(&SDL_HIDAPI_spinlock);
         }
     }
@@ -1170,9 +1306,16 @@ HIDAPI_JoystickDetect(void)
         HIDAPI_UpdateDiscovery();
         if (SDL_HIDAPI_discovery.m_bHaveDevicesChanged) {
             /* FIXME: We probably need to schedule an update in a few seconds as well */
-            HIDAPI_UpdateDeviceList();
+            HIDAPI_UpdateDeviceList(0);
             SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_FALSE;
+        } else {
+            int i;
+
+            for (i = 0; i < SDL_HIDAPI_discovery.m_nPendingVendors; ++i) {
+                HIDAPI_UpdateDeviceList(SDL_HIDAPI_discovery.m_unPendingVendors[i]);
+            }
         }
+        SDL_HIDAPI_discovery.m_nPendingVendors = 0;
         SDL_AtomicUnlock(&SDL_HIDAPI_spinlock);
     }
 }
@@ -72,6 +72,7 @@ typedef struct _SDL_HIDAPI_Device
     SDL_mutex *dev_lock;
     hid_device *dev;
     SDL_atomic_t rumble_pending;
+    Uint32 next_output_report;  /* only used by the rumble thread */
     int num_joysticks;
     SDL_JoystickID *joysticks;
 
@@ -82,6 +83,7 @@ typedef struct _SDL_HIDAPI_Device
     SDL_bool updating;
 
     struct _SDL_HIDAPI_Device *next;
+    struct _SDL_HIDAPI_Device *hash_next;   /* Devices with the same path hash */
 } SDL_HIDAPI_Device;
 
 typedef struct _SDL_HIDAPI_DeviceDriver
@@ -29,6 +29,8 @@
 /* This is the Linux implementation of the SDL joystick API */
 
 #include <sys/stat.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <errno.h>              /* errno, strerror */
 #include <fcntl.h>
 #include <limits.h>             /* For the definition of PATH_MAX */
@@ -46,6 +48,7 @@
 #include "SDL_endian.h"
 #include "SDL_timer.h"
 #include "../../events/SDL_events_c.h"
+#include "../../thread/SDL_systhread.h"
 #include "../SDL_sysjoystick.h"
 #include "../SDL_joystick_c.h"
 #include "../steam/SDL_steamcontroller.h"
@@ -87,6 +90,10 @@ static EnumerationMethod enumeration_method = ENUMERATION_UNSET;
 
 static int MaybeAddDevice(const char *path);
 static int MaybeRemoveDevice(const char *path);
+static int SDL_StartJoystickThread(void);
+static void SDL_StopJoystickThread(void);
+static void StartThreadedJoystick(SDL_Joystick *joystick);
+static void StopThreadedJoystick(SDL_Joystick *joystick);
 
 /* A linked list of available joysticks */
 typedef struct SDL_joylist_item
@@ -113,6 +120,16 @@ static int inotify_fd = -1;
 static Uint32 last_joy_detect_time;
 static time_t last_input_dir_mtime;
 
+/* The optional input thread, see SDL_HINT_JOYSTICK_THREAD */
+static SDL_Thread *joystick_thread = NULL;
+static SDL_atomic_t joystick_thread_quit;
+static int joystick_epoll_fd = -1;
+static int joystick_wakeup_fd = -1;
+
+/* The joysticks read by the input thread, they are only decoded with this held */
+static SDL_mutex *joystick_thread_lock = NULL;
+static SDL_Joystick *threaded_joysticks = NULL;
+
 static void
 FixupDeviceInfoForMapping(int fd, struct input_id *inpid)
 {
@@ -744,6 +761,14 @@ LINUX_JoystickInit(void)
         LINUX_JoystickDetect();
     }
 
+    if (SDL_GetHintBoolean(SDL_HINT_JOYSTICK_THREAD, SDL_FALSE)) {
+        if (SDL_StartJoystickThread() < 0) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_INPUT,
+                        "Unable to start joystick input thread, falling back to polling: %s",
+                        SDL_GetError());
+        }
+    }
+
     return 0;
 }
 
@@ -1018,14 +1043,19 @@ LINUX_JoystickOpen(SDL_Joystick *joystick, int device_index)
 
         /* Get the number of buttons and axes on the joystick */
         ConfigJoystick(joystick, fd);
+
+        /* mark joystick as fresh and ready */
+        joystick->hwdata->fresh = SDL_TRUE;
+
+        /* Let the input thread read the device, if there is one */
+        if (joystick_thread) {
+            StartThreadedJoystick(joystick);
+        }
     }
 
     SDL_assert(item->hwdata == NULL);
     item->hwdata = joystick->hwdata;
 
-    /* mark joystick as fresh and ready */
-    joystick->hwdata->fresh = SDL_TRUE;
-
     return (0);
 }
 
@@ -1101,6 +1131,130 @@ LINUX_JoystickSetSensorsEnabled(SDL_Joystick *joystick, SDL_bool enabled)
     return SDL_Unsupported();
 }
 
+static void
+FreeSnapshot(joystick_snapshot *snapshot)
+{
+    SDL_free(snapshot->axes);
+    SDL_free(snapshot->buttons);
+    SDL_free(snapshot->button_changes);
+    SDL_free(snapshot->hats);
+    SDL_free(snapshot->balls);
+    SDL_zerop(snapshot);
+}
+
+static int
+AllocSnapshot(SDL_Joystick *joystick, joystick_snapshot *snapshot)
+{
+    /* Allocate at least one of each, so that NULL always means failure */
+    snapshot->axes = (Sint16 *)SDL_calloc(joystick->naxes + 1, sizeof(*snapshot->axes));
+    snapshot->buttons = (Uint8 *)SDL_calloc(joystick->nbuttons + 1, sizeof(*snapshot->buttons));
+    snapshot->button_changes = (Uint32 *)SDL_calloc(joystick->nbuttons + 1, sizeof(*snapshot->button_changes));
+    snapshot->hats = (Uint8 *)SDL_calloc(joystick->nhats + 1, sizeof(*snapshot->hats));
+    snapshot->balls = (Uint32 *)SDL_calloc(joystick->nballs * 2 + 1, sizeof(*snapshot->balls));
+    if (!snapshot->axes || !snapshot->buttons || !snapshot->button_changes ||
+        !snapshot->hats || !snapshot->balls) {
+        FreeSnapshot(snapshot);
+        return SDL_OutOfMemory();
+    }
+    return 0;
+}
+
+static void
+CopySnapshot(SDL_Joystick *joystick, joystick_snapshot *dst, const joystick_snapshot *src)
+{
+    SDL_memcpy(dst->axes, src->axes, joystick->naxes * sizeof(*dst->axes));
+    SDL_memcpy(dst->buttons, src->buttons, joystick->nbuttons * sizeof(*dst->buttons));
+    SDL_memcpy(dst->button_changes, src->button_changes, joystick->nbuttons * sizeof(*dst->button_changes));
+    SDL_memcpy(dst->hats, src->hats, joystick->nhats * sizeof(*dst->hats));
+    SDL_memcpy(dst->balls, src->balls, joystick->nballs * 2 * sizeof(*dst->balls));
+    dst->gone = src->gone;
+}
+
+/* Makes the state decoded so far visible to LINUX_JoystickUpdate(). Only the
+   input thread calls this once the device is in the epoll set. */
+static void
+PublishSnapshot(SDL_Joystick *joystick)
+{
+    struct joystick_hwdata *hwdata = joystick->hwdata;
+
+    /* The sequence number is odd while the copy is going on */
+    SDL_AtomicIncRef(&hwdata->live.sequence);
+    SDL_MemoryBarrierRelease();
+    CopySnapshot(joystick, &hwdata->published, &hwdata->working);
+    hwdata->live.timestamp = SDL_GetPerformanceCounter();
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicIncRef(&hwdata->live.sequence);
+}
+
+/* Copies the latest published state into hwdata->next, returns SDL_FALSE if
+   nothing was published since the last call */
+static SDL_bool
+ReadSnapshot(SDL_Joystick *joystick)
+{
+    struct joystick_hwdata *hwdata = joystick->hwdata;
+    int sequence;
+
+    for (;;) {
+        sequence = SDL_AtomicGet(&hwdata->live.sequence);
+        if (sequence == hwdata->read_sequence) {
+            return SDL_FALSE;
+        }
+        if (sequence & 1) {
+            /* The input thread is publishing, let it finish */
+            SDL_Delay(0);
+            continue;
+        }
+        SDL_MemoryBarrierAcquire();
+        CopySnapshot(joystick, &hwdata->next, &hwdata->published);
+        SDL_MemoryBarrierAcquire();
+        if (SDL_AtomicGet(&hwdata->live.sequence) == sequence) {
+            break;
+        }
+    }
+    hwdata->read_sequence = sequence;
+    return SDL_TRUE;
+}
+
+/* These send the decoded input to SDL, or with the input thread, record it
+   in the snapshot that is published at the end of the frame */
+static SDL_INLINE void
+ReportAxis(SDL_Joystick *joystick, Uint8 axis, Sint16 value)
+{
+    if (joystick->hwdata->threaded) {
+        if (axis < joystick->naxes) {
+            joystick->hwdata->working.axes[axis] = value;
+        }
+    } else {
+        SDL_PrivateJoystickAxis(joystick, axis, value);
+    }
+}
+
+static SDL_INLINE void
+ReportButton(SDL_Joystick *joystick, Uint8 button, Uint8 state)
+{
+    if (joystick->hwdata->threaded) {
+        state = state ? SDL_PRESSED : SDL_RELEASED;
+        if (button < joystick->nbuttons && joystick->hwdata->working.buttons[button] != state) {
+            joystick->hwdata->working.buttons[button] = state;
+            ++joystick->hwdata->working.button_changes[button];
+        }
+    } else {
+        SDL_PrivateJoystickButton(joystick, button, state);
+    }
+}
+
+static SDL_INLINE void
+ReportHat(SDL_Joystick *joystick, Uint8 hat, Uint8 value)
+{
+    if (joystick->hwdata->threaded) {
+        if (hat < joystick->nhats) {
+            joystick->hwdata->working.hats[hat] = value;
+        }
+    } else {
+        SDL_PrivateJoystickHat(joystick, hat, value);
+    }
+}
+
 static SDL_INLINE void
 HandleHat(SDL_Joystick *stick, Uint8 hat, int axis, int value)
 {
@@ -1121,15 +1275,20 @@ HandleHat(SDL_Joystick *stick, Uint8 hat, int axis, int value)
     }
     if (value != the_hat->axis[axis]) {
         the_hat->axis[axis] = value;
-        SDL_PrivateJoystickHat(stick, hat,
-                               position_map[the_hat->axis[1]][the_hat->axis[0]]);
+        ReportHat(stick, hat, position_map[the_hat->axis[1]][the_hat->axis[0]]);
     }
 }
 
 static SDL_INLINE void
 HandleBall(SDL_Joystick *stick, Uint8 ball, int axis, int value)
 {
-    stick->hwdata->balls[ball].axis[axis] += value;
+    if (stick->hwdata->threaded) {
+        if (ball < stick->nballs) {
+            stick->hwdata->working.balls[ball * 2 + axis] += (Uint32)value;
+        }
+    } else {
+        stick->hwdata->balls[ball].axis[axis] += value;
+    }
 }
 
 
@@ -1188,9 +1347,7 @@ PollAllValues(SDL_Joystick *joystick)
                 printf("Joystick : Re-read Axis %d (%d) val= %d\n",
                     joystick->hwdata->abs_map[i], i, absinfo.value);
 #endif
-                SDL_PrivateJoystickAxis(joystick,
-                        joystick->hwdata->abs_map[i],
-                        absinfo.value);
+                ReportAxis(joystick, joystick->hwdata->abs_map[i], absinfo.value);
             }
         }
     }
@@ -1218,8 +1375,7 @@ PollAllValues(SDL_Joystick *joystick)
                 printf("Joystick : Re-read Button %d (%d) val= %d\n",
                     joystick->hwdata->key_map[i], i, value);
 #endif
-                SDL_PrivateJoystickButton(joystick,
-                        joystick->hwdata->key_map[i], value);
+                ReportButton(joystick, joystick->hwdata->key_map[i], value);
             }
         }
     }
@@ -1253,9 +1409,7 @@ HandleInputEvents(SDL_Joystick *joystick)
 
             switch (events[i].type) {
             case EV_KEY:
-                SDL_PrivateJoystickButton(joystick,
-                                          joystick->hwdata->key_map[code],
-                                          events[i].value);
+                ReportButton(joystick, joystick->hwdata->key_map[code], events[i].value);
                 break;
             case EV_ABS:
                 switch (code) {
@@ -1274,9 +1428,7 @@ HandleInputEvents(SDL_Joystick *joystick)
                     if (joystick->hwdata->abs_map[code] != 0xFF) {
                         events[i].value =
                             AxisCorrect(joystick, code, events[i].value);
-                        SDL_PrivateJoystickAxis(joystick,
-                                                joystick->hwdata->abs_map[code],
-                                                events[i].value);
+                        ReportAxis(joystick, joystick->hwdata->abs_map[code], events[i].value);
                     }
                     break;
                 }
@@ -1305,6 +1457,9 @@ HandleInputEvents(SDL_Joystick *joystick)
                         joystick->hwdata->recovering_from_dropped = SDL_FALSE;
                         PollAllValues(joystick);  /* try to sync up to current state now */
                     }
+                    if (joystick->hwdata->threaded) {
+                        PublishSnapshot(joystick);
+                    }
                     break;
                 default:
                     break;
@@ -1317,10 +1472,70 @@ HandleInputEvents(SDL_Joystick *joystick)
 
     if (errno == ENODEV) {
         /* We have to wait until the JoystickDetect callback to remove this */
-        joystick->hwdata->gone = SDL_TRUE;
+        if (joystick->hwdata->threaded) {
+            joystick->hwdata->working.gone = SDL_TRUE;
+            PublishSnapshot(joystick);
+        } else {
+            joystick->hwdata->gone = SDL_TRUE;
+        }
     }
 }
 
+/* Sends the events for whatever changed in the latest snapshot the input
+   thread published. This runs without the joystick lock, like any update. */
+static void
+SendSnapshotEvents(SDL_Joystick *joystick)
+{
+    struct joystick_hwdata *hwdata = joystick->hwdata;
+    const SDL_bool first = (hwdata->read_sequence == 0);
+    joystick_snapshot *previous, *snapshot, swap;
+    int i;
+
+    if (!ReadSnapshot(joystick)) {
+        return;
+    }
+    previous = &hwdata->current;
+    snapshot = &hwdata->next;
+
+    for (i = 0; i < joystick->naxes; ++i) {
+        if (first || snapshot->axes[i] != previous->axes[i]) {
+            SDL_PrivateJoystickAxis(joystick, (Uint8) i, snapshot->axes[i]);
+        }
+    }
+
+    for (i = 0; i < joystick->nbuttons; ++i) {
+        if (snapshot->button_changes[i] != previous->button_changes[i] &&
+            snapshot->buttons[i] == previous->buttons[i]) {
+            /* It went the other way and back between two updates */
+            SDL_PrivateJoystickButton(joystick, (Uint8) i,
+                snapshot->buttons[i] == SDL_PRESSED ? SDL_RELEASED : SDL_PRESSED);
+        }
+        if (first || snapshot->button_changes[i] != previous->button_changes[i]) {
+            SDL_PrivateJoystickButton(joystick, (Uint8) i, snapshot->buttons[i]);
+        }
+    }
+
+    for (i = 0; i < joystick->nhats; ++i) {
+        if (first || snapshot->hats[i] != previous->hats[i]) {
+            SDL_PrivateJoystickHat(joystick, (Uint8) i, snapshot->hats[i]);
+        }
+    }
+
+    for (i = 0; i < joystick->nballs; ++i) {
+        const Sint16 xrel = (Sint16)(snapshot->balls[i * 2] - previous->balls[i * 2]);
+        const Sint16 yrel = (Sint16)(snapshot->balls[i * 2 + 1] - previous->balls[i * 2 + 1]);
+        if (xrel || yrel) {
+            SDL_PrivateJoystickBall(joystick, (Uint8) i, xrel, yrel);
+        }
+    }
+
+    hwdata->gone = snapshot->gone;
+
+    swap = hwdata->current;
+    hwdata->current = hwdata->next;
+    hwdata->next = swap;
+}
+
 static void
 LINUX_JoystickUpdate(SDL_Joystick *joystick)
 {
@@ -1331,6 +1546,11 @@ LINUX_JoystickUpdate(SDL_Joystick *joystick)
         return;
     }
 
+    if (joystick->hwdata->threaded) {
+        SendSnapshotEvents(joystick);
+        return;
+    }
+
     HandleInputEvents(joystick);
 
     /* Deliver ball motion updates */
@@ -1347,6 +1567,197 @@ LINUX_JoystickUpdate(SDL_Joystick *joystick)
     }
 }
 
+static void
+FreeThreadedSnapshots(struct joystick_hwdata *hwdata)
+{
+    FreeSnapshot(&hwdata->working);
+    FreeSnapshot(&hwdata->published);
+    FreeSnapshot(&hwdata->current);
+    FreeSnapshot(&hwdata->next);
+}
+
+/* Hands the device over to the input thread, it's polled as usual if that fails */
+static void
+StartThreadedJoystick(SDL_Joystick *joystick)
+{
+    struct joystick_hwdata *hwdata = joystick->hwdata;
+    struct epoll_event event;
+
+    if (AllocSnapshot(joystick, &hwdata->working) < 0 ||
+        AllocSnapshot(joystick, &hwdata->published) < 0 ||
+        AllocSnapshot(joystick, &hwdata->current) < 0 ||
+        AllocSnapshot(joystick, &hwdata->next) < 0) {
+        FreeThreadedSnapshots(hwdata);
+        return;
+    }
+
+    /* The thread won't touch the device before it's in the list */
+    SDL_LockMutex(joystick_thread_lock);
+
+    SDL_zero(event);
+    event.events = EPOLLIN;
+    event.data.ptr = joystick;
+    if (epoll_ctl(joystick_epoll_fd, EPOLL_CTL_ADD, hwdata->fd, &event) < 0) {
+        SDL_UnlockMutex(joystick_thread_lock);
+        FreeThreadedSnapshots(hwdata);
+        return;
+    }
+
+    /* Read the initial state here, the thread only hears about changes */
+    hwdata->threaded = SDL_TRUE;
+    PollAllValues(joystick);
+    PublishSnapshot(joystick);
+    hwdata->fresh = SDL_FALSE;
+
+    /* From now on the state queries see the input as soon as it's read */
+    hwdata->live.axes = hwdata->published.axes;
+    hwdata->live.buttons = hwdata->published.buttons;
+    hwdata->live.hats = hwdata->published.hats;
+    joystick->live_state = &hwdata->live;
+
+    hwdata->next_threaded = threaded_joysticks;
+    threaded_joysticks = joystick;
+
+    SDL_UnlockMutex(joystick_thread_lock);
+}
+
+static void
+StopThreadedJoystick(SDL_Joystick *joystick)
+{
+    struct joystick_hwdata *hwdata = joystick->hwdata;
+    SDL_Joystick **prev;
+
+    SDL_LockMutex(joystick_thread_lock);
+    epoll_ctl(joystick_epoll_fd, EPOLL_CTL_DEL, hwdata->fd, NULL);
+    for (prev = &threaded_joysticks; *prev; prev = &(*prev)->hwdata->next_threaded) {
+        if (*prev == joystick) {
+            *prev = hwdata->next_threaded;
+            break;
+        }
+    }
+    hwdata->threaded = SDL_FALSE;
+    SDL_UnlockMutex(joystick_thread_lock);
+
+    joystick->live_state = NULL;
+    SDL_zero(hwdata->live);
+    FreeThreadedSnapshots(hwdata);
+}
+
+static int SDLCALL
+LINUX_JoystickThread(void *data)
+{
+    struct epoll_event events[16];
+
+    while (!SDL_AtomicGet(&joystick_thread_quit)) {
+        int i, count;
+
+        count = epoll_wait(joystick_epoll_fd, events, SDL_arraysize(events), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        /* This only decodes into the snapshots, the events are sent from
+           SDL_JoystickUpdate() on the application's thread */
+        SDL_LockMutex(joystick_thread_lock);
+        for (i = 0; i < count; ++i) {
+            SDL_Joystick *joystick;
+
+            if (events[i].data.ptr == NULL) {
+                continue;   /* woken up to quit */
+            }
+
+            /* The joystick may have been closed since epoll_wait() returned */
+            for (joystick = threaded_joysticks; joystick; joystick = joystick->hwdata->next_threaded) {
+                if (joystick == events[i].data.ptr) {
+                    break;
+                }
+            }
+            if (!joystick) {
+                continue;
+            }
+
+            HandleInputEvents(joystick);
+
+            if (joystick->hwdata->working.gone) {
+                /* Stop polling it, JoystickDetect will take care of the rest */
+                epoll_ctl(joystick_epoll_fd, EPOLL_CTL_DEL, joystick->hwdata->fd, NULL);
+            }
+        }
+        SDL_UnlockMutex(joystick_thread_lock);
+    }
+    return 0;
+}
+
+static int
+SDL_StartJoystickThread(void)
+{
+    struct epoll_event event;
+
+    joystick_thread_lock = SDL_CreateMutex();
+    if (!joystick_thread_lock) {
+        return -1;
+    }
+
+    joystick_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    joystick_wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (joystick_epoll_fd < 0 || joystick_wakeup_fd < 0) {
+        SDL_SetError("Couldn't create joystick epoll set: %s", strerror(errno));
+        SDL_StopJoystickThread();
+        return -1;
+    }
+
+    SDL_zero(event);
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    if (epoll_ctl(joystick_epoll_fd, EPOLL_CTL_ADD, joystick_wakeup_fd, &event) < 0) {
+        SDL_SetError("Couldn't add joystick wakeup event: %s", strerror(errno));
+        SDL_StopJoystickThread();
+        return -1;
+    }
+
+    SDL_AtomicSet(&joystick_thread_quit, 0);
+    joystick_thread = SDL_CreateThreadInternal(LINUX_JoystickThread, "SDL_joystick", 64 * 1024, NULL);
+    if (!joystick_thread) {
+        SDL_StopJoystickThread();
+        return -1;
+    }
+    return 0;
+}
+
+static void
+SDL_StopJoystickThread(void)
+{
+    if (joystick_thread) {
+        const Uint64 wakeup = 1;
+
+        SDL_AtomicSet(&joystick_thread_quit, 1);
+        if (write(joystick_wakeup_fd, &wakeup, sizeof(wakeup)) < 0) {
+            /* The eventfd counter can't overflow here, nothing to do */
+        }
+
+        /* The thread never takes the joystick lock, so it can be joined
+           however deeply SDL_JoystickQuit() holds that */
+        SDL_WaitThread(joystick_thread, NULL);
+        joystick_thread = NULL;
+    }
+
+    if (joystick_wakeup_fd >= 0) {
+        close(joystick_wakeup_fd);
+        joystick_wakeup_fd = -1;
+    }
+    if (joystick_epoll_fd >= 0) {
+        close(joystick_epoll_fd);
+        joystick_epoll_fd = -1;
+    }
+    if (joystick_thread_lock) {
+        SDL_DestroyMutex(joystick_thread_lock);
+        joystick_thread_lock = NULL;
+    }
+}
+
 /* Function to close a joystick after use */
 static void
 LINUX_JoystickClose(SDL_Joystick *joystick)
@@ -1356,6 +1767,9 @@ LINUX_JoystickClose(SDL_Joystick *joystick)
             ioctl(joystick->hwdata->fd, EVIOCRMFF, joystick->hwdata->effect.id);
             joystick->hwdata->effect.id = -1;
         }
+        if (joystick->hwdata->threaded) {
+            StopThreadedJoystick(joystick);
+        }
         if (joystick->hwdata->fd >= 0) {
             close(joystick->hwdata->fd);
         }
@@ -1376,6 +1790,8 @@ LINUX_JoystickQuit(void)
     SDL_joylist_item *item = NULL;
     SDL_joylist_item *next = NULL;
 
+    SDL_StopJoystickThread();
+
     if (inotify_fd >= 0) {
         close(inotify_fd);
         inotify_fd = -1;
@@ -26,6 +26,17 @@
 
 struct SDL_joylist_item;
 
+/* The state of a device read by the joystick input thread */
+typedef struct joystick_snapshot
+{
+    Sint16 *axes;
+    Uint8 *buttons;
+    Uint32 *button_changes;     /* presses and releases so far, so quick taps aren't lost */
+    Uint8 *hats;
+    Uint32 *balls;              /* relative motion so far, x and y for each ball */
+    SDL_bool gone;
+} joystick_snapshot;
+
 /* The private structure used to keep track of a joystick */
 struct joystick_hwdata
 {
@@ -81,6 +92,22 @@ struct joystick_hwdata
 
     /* Set when gamepad is pending removal due to ENODEV read error */
     SDL_bool gone;
+
+    /* Set when the device is read by the joystick input thread */
+    SDL_bool threaded;
+    struct _SDL_Joystick *next_threaded;
+
+    /* The input thread decodes events into 'working' and copies each
+       complete frame to 'published', protected by the sequence lock in
+       'live', which also lets the state queries read it directly.
+       LINUX_JoystickUpdate() copies it to 'next', sends events for the
+       differences from 'current', then swaps the two. */
+    joystick_snapshot working;
+    joystick_snapshot published;
+    joystick_snapshot current;
+    joystick_snapshot next;
+    SDL_JoystickLiveState live;
+    int read_sequence;
 };
 
 #endif /* SDL_sysjoystick_c_h_ */
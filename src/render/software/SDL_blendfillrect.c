@@ -22,9 +22,174 @@
 
 #if SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED
 
+#include "SDL_cpuinfo.h"
 #include "SDL_draw.h"
 #include "SDL_blendfillrect.h"
 
+#if defined(__SSE2__)
+
+/* x / 255 for x in [0, 255*255], rounding down like DRAW_MUL() */
+#define DIV255_SSE2(x) \
+    _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8)
+
+/* Runs op over each row of the rect, n pixels of the given type at a time
+   in the __m128i v. The pixels left over at the end of a row go through a
+   small buffer so that every pixel gets exactly the same arithmetic. */
+#define FILLRECT_SSE2(type, n, op) \
+do { \
+    int width = rect->w; \
+    int height = rect->h; \
+    int pitch = (dst->pitch / dst->format->BytesPerPixel); \
+    type *row = (type *)dst->pixels + rect->y * pitch + rect->x; \
+    while (height--) { \
+        type *pixel = row; \
+        int x; \
+        __m128i v; \
+        for (x = width; x >= n; x -= n, pixel += n) { \
+            v = _mm_loadu_si128((const __m128i *)pixel); \
+            op; \
+            _mm_storeu_si128((__m128i *)pixel, v); \
+        } \
+        if (x > 0) { \
+            type tail[n]; \
+            SDL_memcpy(tail, pixel, x * sizeof(type)); \
+            v = _mm_loadu_si128((const __m128i *)tail); \
+            op; \
+            _mm_storeu_si128((__m128i *)tail, v); \
+            SDL_memcpy(pixel, tail, x * sizeof(type)); \
+        } \
+        row += pitch; \
+    } \
+} while (0)
+
+/* Blends, adds or modulates a constant color into 8888 pixels with the
+   same results as the DRAW_SETPIXEL_*_ARGB8888 and _RGB888 operators.
+   keep is 0x00FFFFFF for RGB888, where the unused byte is always zero. */
+static SDL_bool
+SDL_BlendFillRect8888_SSE2(SDL_Surface * dst, const SDL_Rect * rect,
+                           SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a,
+                           Uint32 keep)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask = _mm_set1_epi32((int)keep);
+    __m128i color, lo, hi;
+
+    switch (blendMode) {
+    case SDL_BLENDMODE_BLEND:
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        {
+            /* A premultiplied color can be brighter than its alpha, but the
+               sum fits in 16 bits and packing saturates it to 255 */
+            const __m128i inva = _mm_set1_epi16(0xff - a);
+            color = _mm_set_epi16(a, r, g, b, a, r, g, b);
+            FILLRECT_SSE2(Uint32, 4, {
+                lo = _mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), inva);
+                hi = _mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), inva);
+                lo = _mm_add_epi16(DIV255_SSE2(lo), color);
+                hi = _mm_add_epi16(DIV255_SSE2(hi), color);
+                v = _mm_and_si128(_mm_packus_epi16(lo, hi), mask);
+            });
+        }
+        return SDL_TRUE;
+    case SDL_BLENDMODE_ADD:
+        color = _mm_set1_epi32((int)(((Uint32)r << 16) | ((Uint32)g << 8) | b));
+        FILLRECT_SSE2(Uint32, 4, {
+            v = _mm_and_si128(_mm_adds_epu8(v, color), mask);
+        });
+        return SDL_TRUE;
+    case SDL_BLENDMODE_MOD:
+        /* Multiplying the alpha by 255 leaves it as it was */
+        color = _mm_set_epi16(0xff, r, g, b, 0xff, r, g, b);
+        FILLRECT_SSE2(Uint32, 4, {
+            lo = _mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), color);
+            hi = _mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), color);
+            v = _mm_and_si128(_mm_packus_epi16(DIV255_SSE2(lo), DIV255_SSE2(hi)), mask);
+        });
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+/* The RGB565 equivalent, working on 8 pixels at a time. The channels are
+   widened the way RGB_FROM_RGB565() does it and truncated back. */
+static SDL_bool
+SDL_BlendFillRect565_SSE2(SDL_Surface * dst, const SDL_Rect * rect,
+                          SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+    const __m128i expand5 = _mm_set1_epi16(2106);
+    const __m128i expand6 = _mm_set1_epi16(49);
+    const __m128i vr = _mm_set1_epi16(r);
+    const __m128i vg = _mm_set1_epi16(g);
+    const __m128i vb = _mm_set1_epi16(b);
+    const __m128i inva = _mm_set1_epi16(0xff - a);
+    const __m128i max = _mm_set1_epi16(0xff);
+    __m128i pr, pg, pb;
+
+#define UNPACK_RGB565_SSE2 \
+    pr = _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi16(v, 11), expand5), 8); \
+    pg = _mm_and_si128(_mm_srli_epi16(v, 5), mask6); \
+    pg = _mm_add_epi16(_mm_slli_epi16(pg, 2), _mm_srli_epi16(_mm_mullo_epi16(pg, expand6), 10)); \
+    pb = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(v, mask5), expand5), 8)
+
+#define PACK_RGB565_SSE2 \
+    v = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(pr, 3), 11), \
+                                  _mm_slli_epi16(_mm_srli_epi16(pg, 2), 5)), \
+                     _mm_srli_epi16(pb, 3))
+
+    switch (blendMode) {
+    case SDL_BLENDMODE_BLEND:
+        FILLRECT_SSE2(Uint16, 8, {
+            UNPACK_RGB565_SSE2;
+            pr = _mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(pr, inva)), vr);
+            pg = _mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(pg, inva)), vg);
+            pb = _mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(pb, inva)), vb);
+            PACK_RGB565_SSE2;
+        });
+        break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        /* The color can be brighter than its alpha, so saturate each
+           channel before packing it back into its field */
+        FILLRECT_SSE2(Uint16, 8, {
+            UNPACK_RGB565_SSE2;
+            pr = _mm_min_epi16(_mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(pr, inva)), vr), max);
+            pg = _mm_min_epi16(_mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(pg, inva)), vg), max);
+            pb = _mm_min_epi16(_mm_add_epi16(DIV255_SSE2(_mm_mullo_epi16(pb, inva)), vb), max);
+            PACK_RGB565_SSE2;
+        });
+        break;
+    case SDL_BLENDMODE_ADD:
+        FILLRECT_SSE2(Uint16, 8, {
+            UNPACK_RGB565_SSE2;
+            pr = _mm_min_epi16(_mm_add_epi16(pr, vr), max);
+            pg = _mm_min_epi16(_mm_add_epi16(pg, vg), max);
+            pb = _mm_min_epi16(_mm_add_epi16(pb, vb), max);
+            PACK_RGB565_SSE2;
+        });
+        break;
+    case SDL_BLENDMODE_MOD:
+        FILLRECT_SSE2(Uint16, 8, {
+            UNPACK_RGB565_SSE2;
+            pr = DIV255_SSE2(_mm_mullo_epi16(pr, vr));
+            pg = DIV255_SSE2(_mm_mullo_epi16(pg, vg));
+            pb = DIV255_SSE2(_mm_mullo_epi16(pb, vb));
+            PACK_RGB565_SSE2;
+        });
+        break;
+    default:
+        return SDL_FALSE;
+    }
+
+#undef UNPACK_RGB565_SSE2
+#undef PACK_RGB565_SSE2
+
+    return SDL_TRUE;
+}
+
+#endif /* __SSE2__ */
+
 
 static int
 SDL_BlendFillRect_RGB555(SDL_Surface * dst, const SDL_Rect * rect,
@@ -36,6 +201,9 @@ SDL_BlendFillRect_RGB555(SDL_Surface * dst, const SDL_Rect * rect,
     case SDL_BLENDMODE_BLEND:
         FILLRECT(Uint16, DRAW_SETPIXEL_BLEND_RGB555);
         break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        FILLRECT(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB555);
+        break;
     case SDL_BLENDMODE_ADD:
         FILLRECT(Uint16, DRAW_SETPIXEL_ADD_RGB555);
         break;
@@ -58,10 +226,19 @@ SDL_BlendFillRect_RGB565(SDL_Surface * dst, const SDL_Rect * rect,
 {
     unsigned inva = 0xff - a;
 
+#if defined(__SSE2__)
+    if (SDL_HasSSE2() && SDL_BlendFillRect565_SSE2(dst, rect, blendMode, r, g, b, a)) {
+        return 0;
+    }
+#endif
+
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
         FILLRECT(Uint16, DRAW_SETPIXEL_BLEND_RGB565);
         break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        FILLRECT(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB565);
+        break;
     case SDL_BLENDMODE_ADD:
         FILLRECT(Uint16, DRAW_SETPIXEL_ADD_RGB565);
         break;
@@ -84,10 +261,19 @@ SDL_BlendFillRect_RGB888(SDL_Surface * dst, const SDL_Rect * rect,
 {
     unsigned inva = 0xff - a;
 
+#if defined(__SSE2__)
+    if (SDL_HasSSE2() && SDL_BlendFillRect8888_SSE2(dst, rect, blendMode, r, g, b, a, 0x00FFFFFF)) {
+        return 0;
+    }
+#endif
+
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
         FILLRECT(Uint32, DRAW_SETPIXEL_BLEND_RGB888);
         break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        FILLRECT(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB888);
+        break;
     case SDL_BLENDMODE_ADD:
         FILLRECT(Uint32, DRAW_SETPIXEL_ADD_RGB888);
         break;
@@ -110,10 +296,19 @@ SDL_BlendFillRect_ARGB8888(SDL_Surface * dst, const SDL_Rect * rect,
 {
     unsigned inva = 0xff - a;
 
+#if defined(__SSE2__)
+    if (SDL_HasSSE2() && SDL_BlendFillRect8888_SSE2(dst, rect, blendMode, r, g, b, a, 0xFFFFFFFF)) {
+        return 0;
+    }
+#endif
+
     switch (blendMode) {
     case SDL_BLENDMODE_BLEND:
         FILLRECT(Uint32, DRAW_SETPIXEL_BLEND_ARGB8888);
         break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        FILLRECT(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_ARGB8888);
+        break;
     case SDL_BLENDMODE_ADD:
         FILLRECT(Uint32, DRAW_SETPIXEL_ADD_ARGB8888);
         break;
@@ -143,6 +338,9 @@ SDL_BlendFillRect_RGB(SDL_Surface * dst, const SDL_Rect * rect,
         case SDL_BLENDMODE_BLEND:
             FILLRECT(Uint16, DRAW_SETPIXEL_BLEND_RGB);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            FILLRECT(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB);
+            break;
         case SDL_BLENDMODE_ADD:
             FILLRECT(Uint16, DRAW_SETPIXEL_ADD_RGB);
             break;
@@ -162,6 +360,9 @@ SDL_BlendFillRect_RGB(SDL_Surface * dst, const SDL_Rect * rect,
         case SDL_BLENDMODE_BLEND:
             FILLRECT(Uint32, DRAW_SETPIXEL_BLEND_RGB);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            FILLRECT(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB);
+            break;
         case SDL_BLENDMODE_ADD:
             FILLRECT(Uint32, DRAW_SETPIXEL_ADD_RGB);
             break;
@@ -194,6 +395,9 @@ SDL_BlendFillRect_RGBA(SDL_Surface * dst, const SDL_Rect * rect,
         case SDL_BLENDMODE_BLEND:
             FILLRECT(Uint32, DRAW_SETPIXEL_BLEND_RGBA);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            FILLRECT(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGBA);
+            break;
         case SDL_BLENDMODE_ADD:
             FILLRECT(Uint32, DRAW_SETPIXEL_ADD_RGBA);
             break;
@@ -53,6 +53,9 @@ SDL_BlendLine_RGB2(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             HLINE(Uint16, DRAW_SETPIXEL_BLEND_RGB, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            HLINE(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             HLINE(Uint16, DRAW_SETPIXEL_ADD_RGB, draw_end);
             break;
@@ -71,6 +74,9 @@ SDL_BlendLine_RGB2(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             VLINE(Uint16, DRAW_SETPIXEL_BLEND_RGB, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            VLINE(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             VLINE(Uint16, DRAW_SETPIXEL_ADD_RGB, draw_end);
             break;
@@ -89,6 +95,9 @@ SDL_BlendLine_RGB2(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             DLINE(Uint16, DRAW_SETPIXEL_BLEND_RGB, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            DLINE(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             DLINE(Uint16, DRAW_SETPIXEL_ADD_RGB, draw_end);
             break;
@@ -105,29 +114,22 @@ SDL_BlendLine_RGB2(SDL_Surface * dst, int x1, int y1, int x2, int y2,
     } else {
         switch (blendMode) {
         case SDL_BLENDMODE_BLEND:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY2_BLEND_RGB, DRAW_SETPIXELXY2_BLEND_RGB,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_BLEND_RGB, draw_end);
+            break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB, draw_end);
             break;
         case SDL_BLENDMODE_ADD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY2_ADD_RGB, DRAW_SETPIXELXY2_ADD_RGB,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_ADD_RGB, draw_end);
             break;
         case SDL_BLENDMODE_MOD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY2_MOD_RGB, DRAW_SETPIXELXY2_MOD_RGB,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_MOD_RGB, draw_end);
             break;
         case SDL_BLENDMODE_MUL:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY2_MUL_RGB, DRAW_SETPIXELXY2_MUL_RGB,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_MUL_RGB, draw_end);
             break;
         default:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY2_RGB, DRAW_SETPIXELXY2_BLEND_RGB,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_RGB, draw_end);
             break;
         }
     }
@@ -158,6 +160,9 @@ SDL_BlendLine_RGB555(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             HLINE(Uint16, DRAW_SETPIXEL_BLEND_RGB555, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            HLINE(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB555, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             HLINE(Uint16, DRAW_SETPIXEL_ADD_RGB555, draw_end);
             break;
@@ -176,6 +181,9 @@ SDL_BlendLine_RGB555(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             VLINE(Uint16, DRAW_SETPIXEL_BLEND_RGB555, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            VLINE(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB555, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             VLINE(Uint16, DRAW_SETPIXEL_ADD_RGB555, draw_end);
             break;
@@ -194,6 +202,9 @@ SDL_BlendLine_RGB555(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             DLINE(Uint16, DRAW_SETPIXEL_BLEND_RGB555, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            DLINE(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB555, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             DLINE(Uint16, DRAW_SETPIXEL_ADD_RGB555, draw_end);
             break;
@@ -210,29 +221,22 @@ SDL_BlendLine_RGB555(SDL_Surface * dst, int x1, int y1, int x2, int y2,
     } else {
         switch (blendMode) {
         case SDL_BLENDMODE_BLEND:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_BLEND_RGB555, DRAW_SETPIXELXY_BLEND_RGB555,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_BLEND_RGB555, draw_end);
+            break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB555, draw_end);
             break;
         case SDL_BLENDMODE_ADD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_ADD_RGB555, DRAW_SETPIXELXY_ADD_RGB555,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_ADD_RGB555, draw_end);
             break;
         case SDL_BLENDMODE_MOD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_MOD_RGB555, DRAW_SETPIXELXY_MOD_RGB555,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_MOD_RGB555, draw_end);
             break;
         case SDL_BLENDMODE_MUL:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_MUL_RGB555, DRAW_SETPIXELXY_MUL_RGB555,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_MUL_RGB555, draw_end);
             break;
         default:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_RGB555, DRAW_SETPIXELXY_BLEND_RGB555,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_RGB555, draw_end);
             break;
         }
     }
@@ -263,6 +267,9 @@ SDL_BlendLine_RGB565(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             HLINE(Uint16, DRAW_SETPIXEL_BLEND_RGB565, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            HLINE(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB565, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             HLINE(Uint16, DRAW_SETPIXEL_ADD_RGB565, draw_end);
             break;
@@ -281,6 +288,9 @@ SDL_BlendLine_RGB565(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             VLINE(Uint16, DRAW_SETPIXEL_BLEND_RGB565, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            VLINE(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB565, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             VLINE(Uint16, DRAW_SETPIXEL_ADD_RGB565, draw_end);
             break;
@@ -299,6 +309,9 @@ SDL_BlendLine_RGB565(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             DLINE(Uint16, DRAW_SETPIXEL_BLEND_RGB565, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            DLINE(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB565, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             DLINE(Uint16, DRAW_SETPIXEL_ADD_RGB565, draw_end);
             break;
@@ -315,29 +328,22 @@ SDL_BlendLine_RGB565(SDL_Surface * dst, int x1, int y1, int x2, int y2,
     } else {
         switch (blendMode) {
         case SDL_BLENDMODE_BLEND:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_BLEND_RGB565, DRAW_SETPIXELXY_BLEND_RGB565,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_BLEND_RGB565, draw_end);
+            break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB565, draw_end);
             break;
         case SDL_BLENDMODE_ADD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_ADD_RGB565, DRAW_SETPIXELXY_ADD_RGB565,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_ADD_RGB565, draw_end);
             break;
         case SDL_BLENDMODE_MOD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_MOD_RGB565, DRAW_SETPIXELXY_MOD_RGB565,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_MOD_RGB565, draw_end);
             break;
         case SDL_BLENDMODE_MUL:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_MUL_RGB565, DRAW_SETPIXELXY_MUL_RGB565,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_MUL_RGB565, draw_end);
             break;
         default:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_RGB565, DRAW_SETPIXELXY_BLEND_RGB565,
-                   draw_end);
+            BLINE_PTR(Uint16, DRAW_SETPIXEL_RGB565, draw_end);
             break;
         }
     }
@@ -369,6 +375,9 @@ SDL_BlendLine_RGB4(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             HLINE(Uint32, DRAW_SETPIXEL_BLEND_RGB, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            HLINE(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             HLINE(Uint32, DRAW_SETPIXEL_ADD_RGB, draw_end);
             break;
@@ -387,6 +396,9 @@ SDL_BlendLine_RGB4(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             VLINE(Uint32, DRAW_SETPIXEL_BLEND_RGB, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            VLINE(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             VLINE(Uint32, DRAW_SETPIXEL_ADD_RGB, draw_end);
             break;
@@ -405,6 +417,9 @@ SDL_BlendLine_RGB4(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             DLINE(Uint32, DRAW_SETPIXEL_BLEND_RGB, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            DLINE(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             DLINE(Uint32, DRAW_SETPIXEL_ADD_RGB, draw_end);
             break;
@@ -421,29 +436,22 @@ SDL_BlendLine_RGB4(SDL_Surface * dst, int x1, int y1, int x2, int y2,
     } else {
         switch (blendMode) {
         case SDL_BLENDMODE_BLEND:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY4_BLEND_RGB, DRAW_SETPIXELXY4_BLEND_RGB,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_BLEND_RGB, draw_end);
+            break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB, draw_end);
             break;
         case SDL_BLENDMODE_ADD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY4_ADD_RGB, DRAW_SETPIXELXY4_ADD_RGB,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_ADD_RGB, draw_end);
             break;
         case SDL_BLENDMODE_MOD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY4_MOD_RGB, DRAW_SETPIXELXY4_MOD_RGB,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_MOD_RGB, draw_end);
             break;
         case SDL_BLENDMODE_MUL:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY4_MUL_RGB, DRAW_SETPIXELXY4_MUL_RGB,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_MUL_RGB, draw_end);
             break;
         default:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY4_RGB, DRAW_SETPIXELXY4_BLEND_RGB,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_RGB, draw_end);
             break;
         }
     }
@@ -475,6 +483,9 @@ SDL_BlendLine_RGBA4(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             HLINE(Uint32, DRAW_SETPIXEL_BLEND_RGBA, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            HLINE(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGBA, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             HLINE(Uint32, DRAW_SETPIXEL_ADD_RGBA, draw_end);
             break;
@@ -493,6 +504,9 @@ SDL_BlendLine_RGBA4(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             VLINE(Uint32, DRAW_SETPIXEL_BLEND_RGBA, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            VLINE(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGBA, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             VLINE(Uint32, DRAW_SETPIXEL_ADD_RGBA, draw_end);
             break;
@@ -511,6 +525,9 @@ SDL_BlendLine_RGBA4(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             DLINE(Uint32, DRAW_SETPIXEL_BLEND_RGBA, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            DLINE(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGBA, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             DLINE(Uint32, DRAW_SETPIXEL_ADD_RGBA, draw_end);
             break;
@@ -527,29 +544,22 @@ SDL_BlendLine_RGBA4(SDL_Surface * dst, int x1, int y1, int x2, int y2,
     } else {
         switch (blendMode) {
         case SDL_BLENDMODE_BLEND:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY4_BLEND_RGBA, DRAW_SETPIXELXY4_BLEND_RGBA,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_BLEND_RGBA, draw_end);
+            break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGBA, draw_end);
             break;
         case SDL_BLENDMODE_ADD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY4_ADD_RGBA, DRAW_SETPIXELXY4_ADD_RGBA,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_ADD_RGBA, draw_end);
             break;
         case SDL_BLENDMODE_MOD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY4_MOD_RGBA, DRAW_SETPIXELXY4_MOD_RGBA,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_MOD_RGBA, draw_end);
             break;
         case SDL_BLENDMODE_MUL:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY4_MUL_RGBA, DRAW_SETPIXELXY4_MUL_RGBA,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_MUL_RGBA, draw_end);
             break;
         default:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY4_RGBA, DRAW_SETPIXELXY4_BLEND_RGBA,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_RGBA, draw_end);
             break;
         }
     }
@@ -580,6 +590,9 @@ SDL_BlendLine_RGB888(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             HLINE(Uint32, DRAW_SETPIXEL_BLEND_RGB888, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            HLINE(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB888, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             HLINE(Uint32, DRAW_SETPIXEL_ADD_RGB888, draw_end);
             break;
@@ -598,6 +611,9 @@ SDL_BlendLine_RGB888(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             VLINE(Uint32, DRAW_SETPIXEL_BLEND_RGB888, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            VLINE(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB888, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             VLINE(Uint32, DRAW_SETPIXEL_ADD_RGB888, draw_end);
             break;
@@ -616,6 +632,9 @@ SDL_BlendLine_RGB888(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             DLINE(Uint32, DRAW_SETPIXEL_BLEND_RGB888, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            DLINE(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB888, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             DLINE(Uint32, DRAW_SETPIXEL_ADD_RGB888, draw_end);
             break;
@@ -632,29 +651,22 @@ SDL_BlendLine_RGB888(SDL_Surface * dst, int x1, int y1, int x2, int y2,
     } else {
         switch (blendMode) {
         case SDL_BLENDMODE_BLEND:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_BLEND_RGB888, DRAW_SETPIXELXY_BLEND_RGB888,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_BLEND_RGB888, draw_end);
+            break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB888, draw_end);
             break;
         case SDL_BLENDMODE_ADD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_ADD_RGB888, DRAW_SETPIXELXY_ADD_RGB888,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_ADD_RGB888, draw_end);
             break;
         case SDL_BLENDMODE_MOD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_MOD_RGB888, DRAW_SETPIXELXY_MOD_RGB888,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_MOD_RGB888, draw_end);
             break;
         case SDL_BLENDMODE_MUL:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_MUL_RGB888, DRAW_SETPIXELXY_MUL_RGB888,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_MUL_RGB888, draw_end);
             break;
         default:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_RGB888, DRAW_SETPIXELXY_BLEND_RGB888,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_RGB888, draw_end);
             break;
         }
     }
@@ -685,6 +697,9 @@ SDL_BlendLine_ARGB8888(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             HLINE(Uint32, DRAW_SETPIXEL_BLEND_ARGB8888, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            HLINE(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_ARGB8888, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             HLINE(Uint32, DRAW_SETPIXEL_ADD_ARGB8888, draw_end);
             break;
@@ -703,6 +718,9 @@ SDL_BlendLine_ARGB8888(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             VLINE(Uint32, DRAW_SETPIXEL_BLEND_ARGB8888, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            VLINE(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_ARGB8888, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             VLINE(Uint32, DRAW_SETPIXEL_ADD_ARGB8888, draw_end);
             break;
@@ -721,6 +739,9 @@ SDL_BlendLine_ARGB8888(SDL_Surface * dst, int x1, int y1, int x2, int y2,
         case SDL_BLENDMODE_BLEND:
             DLINE(Uint32, DRAW_SETPIXEL_BLEND_ARGB8888, draw_end);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            DLINE(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_ARGB8888, draw_end);
+            break;
         case SDL_BLENDMODE_ADD:
             DLINE(Uint32, DRAW_SETPIXEL_ADD_ARGB8888, draw_end);
             break;
@@ -737,29 +758,22 @@ SDL_BlendLine_ARGB8888(SDL_Surface * dst, int x1, int y1, int x2, int y2,
     } else {
         switch (blendMode) {
         case SDL_BLENDMODE_BLEND:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_BLEND_ARGB8888, DRAW_SETPIXELXY_BLEND_ARGB8888,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_BLEND_ARGB8888, draw_end);
+            break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_ARGB8888, draw_end);
             break;
         case SDL_BLENDMODE_ADD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_ADD_ARGB8888, DRAW_SETPIXELXY_ADD_ARGB8888,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_ADD_ARGB8888, draw_end);
             break;
         case SDL_BLENDMODE_MOD:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_MOD_ARGB8888, DRAW_SETPIXELXY_MOD_ARGB8888,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_MOD_ARGB8888, draw_end);
             break;
         case SDL_BLENDMODE_MUL:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_MUL_ARGB8888, DRAW_SETPIXELXY_MUL_ARGB8888,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_MUL_ARGB8888, draw_end);
             break;
         default:
-            AALINE(x1, y1, x2, y2,
-                   DRAW_SETPIXELXY_ARGB8888, DRAW_SETPIXELXY_BLEND_ARGB8888,
-                   draw_end);
+            BLINE_PTR(Uint32, DRAW_SETPIXEL_ARGB8888, draw_end);
             break;
         }
     }
@@ -835,6 +849,7 @@ SDL_BlendLines(SDL_Surface * dst, const SDL_Point * points, int count,
     int x1, y1;
     int x2, y2;
     SDL_bool draw_end;
+    SDL_bool inside;
     BlendLineFunc func;
 
     if (!dst) {
@@ -846,6 +861,15 @@ SDL_BlendLines(SDL_Surface * dst, const SDL_Point * points, int count,
         return SDL_SetError("SDL_BlendLines(): Unsupported surface format");
     }
 
+    /* Segments only need clipping if some point is outside the clip rect */
+    inside = SDL_TRUE;
+    for (i = 0; i < count; ++i) {
+        if (!SDL_PointInRect(&points[i], &dst->clip_rect)) {
+            inside = SDL_FALSE;
+            break;
+        }
+    }
+
     for (i = 1; i < count; ++i) {
         x1 = points[i-1].x;
         y1 = points[i-1].y;
@@ -854,7 +878,8 @@ SDL_BlendLines(SDL_Surface * dst, const SDL_Point * points, int count,
 
         /* Perform clipping */
         /* FIXME: We don't actually want to clip, as it may change line slope */
-        if (!SDL_IntersectRectAndLine(&dst->clip_rect, &x1, &y1, &x2, &y2)) {
+        if (!inside &&
+            !SDL_IntersectRectAndLine(&dst->clip_rect, &x1, &y1, &x2, &y2)) {
             continue;
         }
 
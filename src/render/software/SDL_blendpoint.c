@@ -36,6 +36,9 @@ SDL_BlendPoint_RGB555(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode,
     case SDL_BLENDMODE_BLEND:
         DRAW_SETPIXELXY_BLEND_RGB555(x, y);
         break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        DRAW_SETPIXELXY_BLEND_PREMULTIPLIED_RGB555(x, y);
+        break;
     case SDL_BLENDMODE_ADD:
         DRAW_SETPIXELXY_ADD_RGB555(x, y);
         break;
@@ -62,6 +65,9 @@ SDL_BlendPoint_RGB565(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode,
     case SDL_BLENDMODE_BLEND:
         DRAW_SETPIXELXY_BLEND_RGB565(x, y);
         break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        DRAW_SETPIXELXY_BLEND_PREMULTIPLIED_RGB565(x, y);
+        break;
     case SDL_BLENDMODE_ADD:
         DRAW_SETPIXELXY_ADD_RGB565(x, y);
         break;
@@ -88,6 +94,9 @@ SDL_BlendPoint_RGB888(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode,
     case SDL_BLENDMODE_BLEND:
         DRAW_SETPIXELXY_BLEND_RGB888(x, y);
         break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        DRAW_SETPIXELXY_BLEND_PREMULTIPLIED_RGB888(x, y);
+        break;
     case SDL_BLENDMODE_ADD:
         DRAW_SETPIXELXY_ADD_RGB888(x, y);
         break;
@@ -114,6 +123,9 @@ SDL_BlendPoint_ARGB8888(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode
     case SDL_BLENDMODE_BLEND:
         DRAW_SETPIXELXY_BLEND_ARGB8888(x, y);
         break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        DRAW_SETPIXELXY_BLEND_PREMULTIPLIED_ARGB8888(x, y);
+        break;
     case SDL_BLENDMODE_ADD:
         DRAW_SETPIXELXY_ADD_ARGB8888(x, y);
         break;
@@ -143,6 +155,9 @@ SDL_BlendPoint_RGB(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode, Uin
         case SDL_BLENDMODE_BLEND:
             DRAW_SETPIXELXY2_BLEND_RGB(x, y);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            DRAW_SETPIXELXY2_BLEND_PREMULTIPLIED_RGB(x, y);
+            break;
         case SDL_BLENDMODE_ADD:
             DRAW_SETPIXELXY2_ADD_RGB(x, y);
             break;
@@ -162,6 +177,9 @@ SDL_BlendPoint_RGB(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode, Uin
         case SDL_BLENDMODE_BLEND:
             DRAW_SETPIXELXY4_BLEND_RGB(x, y);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            DRAW_SETPIXELXY4_BLEND_PREMULTIPLIED_RGB(x, y);
+            break;
         case SDL_BLENDMODE_ADD:
             DRAW_SETPIXELXY4_ADD_RGB(x, y);
             break;
@@ -194,6 +212,9 @@ SDL_BlendPoint_RGBA(SDL_Surface * dst, int x, int y, SDL_BlendMode blendMode, Ui
         case SDL_BLENDMODE_BLEND:
             DRAW_SETPIXELXY4_BLEND_RGBA(x, y);
             break;
+        case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+            DRAW_SETPIXELXY4_BLEND_PREMULTIPLIED_RGBA(x, y);
+            break;
         case SDL_BLENDMODE_ADD:
             DRAW_SETPIXELXY4_ADD_RGBA(x, y);
             break;
@@ -43,6 +43,20 @@
 #define DRAW_FASTSETPIXELXY2(x, y) DRAW_FASTSETPIXELXY(x, y, Uint16, 2, color)
 #define DRAW_FASTSETPIXELXY4(x, y) DRAW_FASTSETPIXELXY(x, y, Uint32, 4, color)
 
+#define DRAW_FASTFILL1(span, length) \
+    SDL_memset(span, (Uint8) color, length)
+
+#define DRAW_FASTFILL2(span, length) \
+do { \
+    Uint16 *p = span, *end = span + (length); \
+    while (p != end) { \
+        *p++ = (Uint16) color; \
+    } \
+} while (0)
+
+#define DRAW_FASTFILL4(span, length) \
+    SDL_memset4(span, color, length)
+
 #define DRAW_SETPIXEL(setpixel) \
 do { \
     unsigned sr = r, sg = g, sb = b, sa = a; (void) sa; \
@@ -60,6 +74,19 @@ do { \
     setpixel; \
 } while (0)
 
+/* The color may be brighter than its alpha, so clamp instead of letting
+   a channel overflow into the next one */
+#define DRAW_SETPIXEL_BLEND_PREMULTIPLIED(getpixel, setpixel) \
+do { \
+    unsigned sr, sg, sb, sa = 0xFF; \
+    getpixel; \
+    sr = DRAW_MUL(inva, sr) + r; if (sr > 0xff) sr = 0xff; \
+    sg = DRAW_MUL(inva, sg) + g; if (sg > 0xff) sg = 0xff; \
+    sb = DRAW_MUL(inva, sb) + b; if (sb > 0xff) sb = 0xff; \
+    sa = DRAW_MUL(inva, sa) + a; if (sa > 0xff) sa = 0xff; \
+    setpixel; \
+} while (0)
+
 #define DRAW_SETPIXEL_ADD(getpixel, setpixel) \
 do { \
     unsigned sr, sg, sb, sa; (void) sa; \
@@ -109,6 +136,10 @@ do { \
     DRAW_SETPIXEL_BLEND(RGB_FROM_RGB555(*pixel, sr, sg, sb), \
                         RGB555_FROM_RGB(*pixel, sr, sg, sb))
 
+#define DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB555 \
+    DRAW_SETPIXEL_BLEND_PREMULTIPLIED(RGB_FROM_RGB555(*pixel, sr, sg, sb), \
+                                      RGB555_FROM_RGB(*pixel, sr, sg, sb))
+
 #define DRAW_SETPIXEL_ADD_RGB555 \
     DRAW_SETPIXEL_ADD(RGB_FROM_RGB555(*pixel, sr, sg, sb), \
                       RGB555_FROM_RGB(*pixel, sr, sg, sb))
@@ -127,6 +158,9 @@ do { \
 #define DRAW_SETPIXELXY_BLEND_RGB555(x, y) \
     DRAW_SETPIXELXY(x, y, Uint16, 2, DRAW_SETPIXEL_BLEND_RGB555)
 
+#define DRAW_SETPIXELXY_BLEND_PREMULTIPLIED_RGB555(x, y) \
+    DRAW_SETPIXELXY(x, y, Uint16, 2, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB555)
+
 #define DRAW_SETPIXELXY_ADD_RGB555(x, y) \
     DRAW_SETPIXELXY(x, y, Uint16, 2, DRAW_SETPIXEL_ADD_RGB555)
 
@@ -147,6 +181,10 @@ do { \
     DRAW_SETPIXEL_BLEND(RGB_FROM_RGB565(*pixel, sr, sg, sb), \
                         RGB565_FROM_RGB(*pixel, sr, sg, sb))
 
+#define DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB565 \
+    DRAW_SETPIXEL_BLEND_PREMULTIPLIED(RGB_FROM_RGB565(*pixel, sr, sg, sb), \
+                                      RGB565_FROM_RGB(*pixel, sr, sg, sb))
+
 #define DRAW_SETPIXEL_ADD_RGB565 \
     DRAW_SETPIXEL_ADD(RGB_FROM_RGB565(*pixel, sr, sg, sb), \
                       RGB565_FROM_RGB(*pixel, sr, sg, sb))
@@ -165,6 +203,9 @@ do { \
 #define DRAW_SETPIXELXY_BLEND_RGB565(x, y) \
     DRAW_SETPIXELXY(x, y, Uint16, 2, DRAW_SETPIXEL_BLEND_RGB565)
 
+#define DRAW_SETPIXELXY_BLEND_PREMULTIPLIED_RGB565(x, y) \
+    DRAW_SETPIXELXY(x, y, Uint16, 2, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB565)
+
 #define DRAW_SETPIXELXY_ADD_RGB565(x, y) \
     DRAW_SETPIXELXY(x, y, Uint16, 2, DRAW_SETPIXEL_ADD_RGB565)
 
@@ -185,6 +226,10 @@ do { \
     DRAW_SETPIXEL_BLEND(RGB_FROM_RGB888(*pixel, sr, sg, sb), \
                         RGB888_FROM_RGB(*pixel, sr, sg, sb))
 
+#define DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB888 \
+    DRAW_SETPIXEL_BLEND_PREMULTIPLIED(RGB_FROM_RGB888(*pixel, sr, sg, sb), \
+                                      RGB888_FROM_RGB(*pixel, sr, sg, sb))
+
 #define DRAW_SETPIXEL_ADD_RGB888 \
     DRAW_SETPIXEL_ADD(RGB_FROM_RGB888(*pixel, sr, sg, sb), \
                       RGB888_FROM_RGB(*pixel, sr, sg, sb))
@@ -203,6 +248,9 @@ do { \
 #define DRAW_SETPIXELXY_BLEND_RGB888(x, y) \
     DRAW_SETPIXELXY(x, y, Uint32, 4, DRAW_SETPIXEL_BLEND_RGB888)
 
+#define DRAW_SETPIXELXY_BLEND_PREMULTIPLIED_RGB888(x, y) \
+    DRAW_SETPIXELXY(x, y, Uint32, 4, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB888)
+
 #define DRAW_SETPIXELXY_ADD_RGB888(x, y) \
     DRAW_SETPIXELXY(x, y, Uint32, 4, DRAW_SETPIXEL_ADD_RGB888)
 
@@ -223,6 +271,10 @@ do { \
     DRAW_SETPIXEL_BLEND(RGBA_FROM_ARGB8888(*pixel, sr, sg, sb, sa), \
                         ARGB8888_FROM_RGBA(*pixel, sr, sg, sb, sa))
 
+#define DRAW_SETPIXEL_BLEND_PREMULTIPLIED_ARGB8888 \
+    DRAW_SETPIXEL_BLEND_PREMULTIPLIED(RGBA_FROM_ARGB8888(*pixel, sr, sg, sb, sa), \
+                                      ARGB8888_FROM_RGBA(*pixel, sr, sg, sb, sa))
+
 #define DRAW_SETPIXEL_ADD_ARGB8888 \
     DRAW_SETPIXEL_ADD(RGBA_FROM_ARGB8888(*pixel, sr, sg, sb, sa), \
                       ARGB8888_FROM_RGBA(*pixel, sr, sg, sb, sa))
@@ -241,6 +293,9 @@ do { \
 #define DRAW_SETPIXELXY_BLEND_ARGB8888(x, y) \
     DRAW_SETPIXELXY(x, y, Uint32, 4, DRAW_SETPIXEL_BLEND_ARGB8888)
 
+#define DRAW_SETPIXELXY_BLEND_PREMULTIPLIED_ARGB8888(x, y) \
+    DRAW_SETPIXELXY(x, y, Uint32, 4, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_ARGB8888)
+
 #define DRAW_SETPIXELXY_ADD_ARGB8888(x, y) \
     DRAW_SETPIXELXY(x, y, Uint32, 4, DRAW_SETPIXEL_ADD_ARGB8888)
 
@@ -261,6 +316,10 @@ do { \
     DRAW_SETPIXEL_BLEND(RGB_FROM_PIXEL(*pixel, fmt, sr, sg, sb), \
                         PIXEL_FROM_RGB(*pixel, fmt, sr, sg, sb))
 
+#define DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB \
+    DRAW_SETPIXEL_BLEND_PREMULTIPLIED(RGB_FROM_PIXEL(*pixel, fmt, sr, sg, sb), \
+                                      PIXEL_FROM_RGB(*pixel, fmt, sr, sg, sb))
+
 #define DRAW_SETPIXEL_ADD_RGB \
     DRAW_SETPIXEL_ADD(RGB_FROM_PIXEL(*pixel, fmt, sr, sg, sb), \
                       PIXEL_FROM_RGB(*pixel, fmt, sr, sg, sb))
@@ -282,9 +341,15 @@ do { \
 #define DRAW_SETPIXELXY2_BLEND_RGB(x, y) \
     DRAW_SETPIXELXY(x, y, Uint16, 2, DRAW_SETPIXEL_BLEND_RGB)
 
+#define DRAW_SETPIXELXY2_BLEND_PREMULTIPLIED_RGB(x, y) \
+    DRAW_SETPIXELXY(x, y, Uint16, 2, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB)
+
 #define DRAW_SETPIXELXY4_BLEND_RGB(x, y) \
     DRAW_SETPIXELXY(x, y, Uint32, 4, DRAW_SETPIXEL_BLEND_RGB)
 
+#define DRAW_SETPIXELXY4_BLEND_PREMULTIPLIED_RGB(x, y) \
+    DRAW_SETPIXELXY(x, y, Uint32, 4, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGB)
+
 #define DRAW_SETPIXELXY2_ADD_RGB(x, y) \
     DRAW_SETPIXELXY(x, y, Uint16, 2, DRAW_SETPIXEL_ADD_RGB)
 
@@ -315,6 +380,10 @@ do { \
     DRAW_SETPIXEL_BLEND(RGBA_FROM_PIXEL(*pixel, fmt, sr, sg, sb, sa), \
                         PIXEL_FROM_RGBA(*pixel, fmt, sr, sg, sb, sa))
 
+#define DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGBA \
+    DRAW_SETPIXEL_BLEND_PREMULTIPLIED(RGBA_FROM_PIXEL(*pixel, fmt, sr, sg, sb, sa), \
+                                      PIXEL_FROM_RGBA(*pixel, fmt, sr, sg, sb, sa))
+
 #define DRAW_SETPIXEL_ADD_RGBA \
     DRAW_SETPIXEL_ADD(RGBA_FROM_PIXEL(*pixel, fmt, sr, sg, sb, sa), \
                       PIXEL_FROM_RGBA(*pixel, fmt, sr, sg, sb, sa))
@@ -333,6 +402,9 @@ do { \
 #define DRAW_SETPIXELXY4_BLEND_RGBA(x, y) \
     DRAW_SETPIXELXY(x, y, Uint32, 4, DRAW_SETPIXEL_BLEND_RGBA)
 
+#define DRAW_SETPIXELXY4_BLEND_PREMULTIPLIED_RGBA(x, y) \
+    DRAW_SETPIXELXY(x, y, Uint32, 4, DRAW_SETPIXEL_BLEND_PREMULTIPLIED_RGBA)
+
 #define DRAW_SETPIXELXY4_ADD_RGBA(x, y) \
     DRAW_SETPIXELXY(x, y, Uint32, 4, DRAW_SETPIXEL_ADD_RGBA)
 
@@ -487,6 +559,100 @@ do { \
     } \
 }
 
+/* Bresenham's line algorithm, stepping a pixel pointer instead of
+   recomputing the address of every pixel. Touches the same pixels as BLINE.
+ */
+#define BLINE_PTR(type, op, draw_end) \
+{ \
+    int pitch = (dst->pitch / dst->format->BytesPerPixel); \
+    int deltax = ABS(x2 - x1); \
+    int deltay = ABS(y2 - y1); \
+    int xstep = (x1 > x2) ? -1 : 1; \
+    int ystep = (y1 > y2) ? -pitch : pitch; \
+    int numpixels, d, dinc1, dinc2, inc1; \
+    type *pixel = (type *)dst->pixels + y1 * pitch + x1; \
+ \
+    if (deltax >= deltay) { \
+        numpixels = deltax + 1; \
+        d = (2 * deltay) - deltax; \
+        dinc1 = deltay * 2; \
+        dinc2 = (deltay - deltax) * 2; \
+        inc1 = xstep; \
+    } else { \
+        numpixels = deltay + 1; \
+        d = (2 * deltax) - deltay; \
+        dinc1 = deltax * 2; \
+        dinc2 = (deltax - deltay) * 2; \
+        inc1 = ystep; \
+    } \
+    if (!draw_end) { \
+        --numpixels; \
+    } \
+    while (numpixels--) { \
+        op; \
+        if (d < 0) { \
+            d += dinc1; \
+            pixel += inc1; \
+        } else { \
+            d += dinc2; \
+            pixel += xstep + ystep; \
+        } \
+    } \
+}
+
+/* Bresenham's line algorithm for solid lines, filling whole spans at once.
+   A mostly horizontal line is a series of horizontal runs, one per row,
+   and each run is handed to fill(pixel, length) starting at its leftmost
+   pixel. Mostly vertical lines have runs one pixel wide and are stored
+   directly. Touches the same pixels as BLINE.
+ */
+#define SPANLINE(type, fill, draw_end) \
+{ \
+    int pitch = (dst->pitch / dst->format->BytesPerPixel); \
+    int deltax = ABS(x2 - x1); \
+    int deltay = ABS(y2 - y1); \
+    int xstep = (x1 > x2) ? -1 : 1; \
+    int ystep = (y1 > y2) ? -pitch : pitch; \
+    int numpixels, d, run; \
+    type *pixel = (type *)dst->pixels + y1 * pitch + x1; \
+ \
+    if (deltax >= deltay) { \
+        type *span; \
+        numpixels = draw_end ? (deltax + 1) : deltax; \
+        d = (2 * deltay) - deltax; \
+        run = 0; \
+        while (numpixels--) { \
+            ++run; \
+            if (d < 0) { \
+                d += deltay * 2; \
+            } else { \
+                d += (deltay - deltax) * 2; \
+                span = (xstep > 0) ? pixel : (pixel - run + 1); \
+                fill(span, run); \
+                pixel += xstep * run + ystep; \
+                run = 0; \
+            } \
+        } \
+        if (run) { \
+            span = (xstep > 0) ? pixel : (pixel - run + 1); \
+            fill(span, run); \
+        } \
+    } else { \
+        numpixels = draw_end ? (deltay + 1) : deltay; \
+        d = (2 * deltax) - deltay; \
+        while (numpixels--) { \
+            *pixel = (type) color; \
+            if (d < 0) { \
+                d += deltax * 2; \
+                pixel += ystep; \
+            } else { \
+                d += (deltax - deltay) * 2; \
+                pixel += xstep + ystep; \
+            } \
+        } \
+    } \
+}
+
 /* Xiaolin Wu's line algorithm, based on Michael Abrash's implementation */
 #define WULINE(x1, y1, x2, y2, opaque_op, blend_op, draw_end) \
 { \
@@ -51,7 +51,7 @@ SDL_DrawLine1(SDL_Surface * dst, int x1, int y1, int x2, int y2, Uint32 color,
     } else if (ABS(x1 - x2) == ABS(y1 - y2)) {
         DLINE(Uint8, DRAW_FASTSETPIXEL1, draw_end);
     } else {
-        BLINE(x1, y1, x2, y2, DRAW_FASTSETPIXELXY1, draw_end);
+        SPANLINE(Uint8, DRAW_FASTFILL1, draw_end);
     }
 }
 
@@ -66,22 +66,7 @@ SDL_DrawLine2(SDL_Surface * dst, int x1, int y1, int x2, int y2, Uint32 color,
     } else if (ABS(x1 - x2) == ABS(y1 - y2)) {
         DLINE(Uint16, DRAW_FASTSETPIXEL2, draw_end);
     } else {
-        Uint8 _r, _g, _b, _a;
-        const SDL_PixelFormat * fmt = dst->format;
-        SDL_GetRGBA(color, fmt, &_r, &_g, &_b, &_a);
-        if (fmt->Rmask == 0x7C00) {
-            AALINE(x1, y1, x2, y2,
-                   DRAW_FASTSETPIXELXY2, DRAW_SETPIXELXY_BLEND_RGB555,
-                   draw_end);
-        } else if (fmt->Rmask == 0xF800) {
-            AALINE(x1, y1, x2, y2,
-                   DRAW_FASTSETPIXELXY2, DRAW_SETPIXELXY_BLEND_RGB565,
-                   draw_end);
-        } else {
-            AALINE(x1, y1, x2, y2,
-                   DRAW_FASTSETPIXELXY2, DRAW_SETPIXELXY2_BLEND_RGB,
-                   draw_end);
-        }
+        SPANLINE(Uint16, DRAW_FASTFILL2, draw_end);
     }
 }
 
@@ -96,24 +81,7 @@ SDL_DrawLine4(SDL_Surface * dst, int x1, int y1, int x2, int y2, Uint32 color,
     } else if (ABS(x1 - x2) == ABS(y1 - y2)) {
         DLINE(Uint32, DRAW_FASTSETPIXEL4, draw_end);
     } else {
-        Uint8 _r, _g, _b, _a;
-        const SDL_PixelFormat * fmt = dst->format;
-        SDL_GetRGBA(color, fmt, &_r, &_g, &_b, &_a);
-        if (fmt->Rmask == 0x00FF0000) {
-            if (!fmt->Amask) {
-                AALINE(x1, y1, x2, y2,
-                       DRAW_FASTSETPIXELXY4, DRAW_SETPIXELXY_BLEND_RGB888,
-                       draw_end);
-            } else {
-                AALINE(x1, y1, x2, y2,
-                       DRAW_FASTSETPIXELXY4, DRAW_SETPIXELXY_BLEND_ARGB8888,
-                       draw_end);
-            }
-        } else {
-            AALINE(x1, y1, x2, y2,
-                   DRAW_FASTSETPIXELXY4, DRAW_SETPIXELXY4_BLEND_RGB,
-                   draw_end);
-        }
+        SPANLINE(Uint32, DRAW_FASTFILL4, draw_end);
     }
 }
 
@@ -170,6 +138,7 @@ SDL_DrawLines(SDL_Surface * dst, const SDL_Point * points, int count,
     int x1, y1;
     int x2, y2;
     SDL_bool draw_end;
+    SDL_bool inside;
     DrawLineFunc func;
 
     if (!dst) {
@@ -181,6 +150,15 @@ SDL_DrawLines(SDL_Surface * dst, const SDL_Point * points, int count,
         return SDL_SetError("SDL_DrawLines(): Unsupported surface format");
     }
 
+    /* Segments only need clipping if some point is outside the clip rect */
+    inside = SDL_TRUE;
+    for (i = 0; i < count; ++i) {
+        if (!SDL_PointInRect(&points[i], &dst->clip_rect)) {
+            inside = SDL_FALSE;
+            break;
+        }
+    }
+
     for (i = 1; i < count; ++i) {
         x1 = points[i-1].x;
         y1 = points[i-1].y;
@@ -189,7 +167,8 @@ SDL_DrawLines(SDL_Surface * dst, const SDL_Point * points, int count,
 
         /* Perform clipping */
         /* FIXME: We don't actually want to clip, as it may change line slope */
-        if (!SDL_IntersectRectAndLine(&dst->clip_rect, &x1, &y1, &x2, &y2)) {
+        if (!inside &&
+            !SDL_IntersectRectAndLine(&dst->clip_rect, &x1, &y1, &x2, &y2)) {
             continue;
         }
 
@@ -43,13 +43,101 @@ typedef struct
     SDL_bool surface_cliprect_dirty;
 } SW_DrawStateCache;
 
+/* How many rotated texture copies are kept around for SDL_RenderCopyEx() */
+#define SW_ROTATION_CACHE_SIZE 8
+
+/* Everything the pixels of a rotated copy depend on. The position on the
+   target only moves the result around, so it isn't part of it. */
+typedef struct
+{
+    SDL_Texture *texture;
+    SDL_Rect srcrect;
+    int w, h;
+    double angle;
+    SDL_RendererFlip flip;
+    SDL_ScaleMode scaleMode;
+    SDL_BlendMode blendMode;
+    Uint8 r, g, b, a;
+} SW_RotationKey;
+
+typedef struct
+{
+    SW_RotationKey key;
+    SDL_Surface *rotated;
+    SDL_Surface *mask;
+    SDL_bool quarter_turn;  /* rotated straight from the texture's pixels by a multiple of 90 degrees */
+    SDL_bool stale;         /* the texture changed since it was rotated */
+    Uint32 last_used;
+} SW_RotationCacheEntry;
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+    SW_RotationCacheEntry rotations[SW_ROTATION_CACHE_SIZE];
+    Uint32 rotation_clock;
+    SDL_Rect damage;        /* the part of the window drawn to since the last present */
+    SDL_bool damage_all;    /* the whole window needs to be presented */
 } SW_RenderData;
 
 
+static void
+SW_FreeRotation(SW_RotationCacheEntry *entry)
+{
+    if (entry->rotated) {
+        SDL_FreeSurface(entry->rotated);
+    }
+    if (entry->mask) {
+        SDL_FreeSurface(entry->mask);
+    }
+    SDL_zerop(entry);
+}
+
+/* Frees the rotated copies of a texture, or all of them if texture is NULL */
+static void
+SW_FreeRotations(SDL_Renderer * renderer, SDL_Texture * texture)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(data->rotations); ++i) {
+        SW_RotationCacheEntry *entry = &data->rotations[i];
+        if (entry->rotated && (!texture || entry->key.texture == texture)) {
+            SW_FreeRotation(entry);
+        }
+    }
+}
+
+/* Marks the rotated copies of a texture as out of date. They keep their
+   surfaces so that quarter turns can be redone in place. */
+static void
+SW_InvalidateRotations(SDL_Renderer * renderer, SDL_Texture * texture)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(data->rotations); ++i) {
+        SW_RotationCacheEntry *entry = &data->rotations[i];
+        if (entry->rotated && entry->key.texture == texture) {
+            entry->stale = SDL_TRUE;
+        }
+    }
+}
+
+/* Records that rect, as far as the clip rect lets it, was drawn to */
+static void
+SW_AddDamage(SW_RenderData *data, SDL_Surface *surface, const SDL_Rect * rect)
+{
+    SDL_Rect clipped;
+
+    if (surface != data->window) {
+        return;  /* drawing to a texture doesn't change what's on screen */
+    }
+    if (SDL_IntersectRect(rect, &surface->clip_rect, &clipped)) {
+        SDL_UnionRect(&data->damage, &clipped, &data->damage);
+    }
+}
+
 static SDL_Surface *
 SW_ActivateRenderer(SDL_Renderer * renderer)
 {
@@ -75,6 +163,9 @@ SW_WindowEvent(SDL_Renderer * renderer, const SDL_WindowEvent *event)
     if (event->event == SDL_WINDOWEVENT_SIZE_CHANGED) {
         data->surface = NULL;
         data->window = NULL;
+        data->damage_all = SDL_TRUE;
+    } else if (event->event == SDL_WINDOWEVENT_EXPOSED) {
+        data->damage_all = SDL_TRUE;
     }
 }
 
@@ -102,6 +193,15 @@ SW_GetOutputSize(SDL_Renderer * renderer, int *w, int *h)
     return -1;
 }
 
+static SDL_bool
+SW_SupportsBlendMode(SDL_Renderer * renderer, SDL_BlendMode blendMode)
+{
+    /* Surfaces can blit pre-multiplied alpha directly, on top of the
+     * blend modes every renderer supports.
+     */
+    return (blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED) ? SDL_TRUE : SDL_FALSE;
+}
+
 static int
 SW_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
@@ -143,6 +243,8 @@ SW_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
     int row;
     size_t length;
 
+    SW_InvalidateRotations(renderer, texture);
+
     if(SDL_MUSTLOCK(surface))
         SDL_LockSurface(surface);
     src = (Uint8 *) pixels;
@@ -166,6 +268,8 @@ SW_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
 
+    SW_InvalidateRotations(renderer, texture);
+
     *pixels =
         (void *) ((Uint8 *) surface->pixels + rect->y * surface->pitch +
                   rect->x * surface->format->BytesPerPixel);
@@ -176,6 +280,7 @@ SW_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
 static void
 SW_UnlockTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
+    SW_InvalidateRotations(renderer, texture);
 }
 
 static void
@@ -189,6 +294,8 @@ SW_SetRenderTarget(SDL_Renderer * renderer, SDL_Texture * texture)
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
     if (texture) {
+        /* Anything drawn from now on changes what its rotations look like */
+        SW_InvalidateRotations(renderer, texture);
         data->surface = (SDL_Surface *) texture->driverdata;
     } else {
         data->surface = data->window;
@@ -333,26 +440,22 @@ SW_QueueCopyEx(SDL_Renderer * renderer, SDL_RenderCommand *cmd, SDL_Texture * te
     return 0;
 }
 
+/* Scales, crops and rotates the texture into entry->rotated, along with the
+   mask the NONE blend mode needs into entry->mask. */
 static int
-SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * texture,
-                const SDL_Rect * srcrect, const SDL_Rect * final_rect,
-                const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip)
+SW_RotateTexture(SW_RotationCacheEntry *entry, SDL_Texture * texture,
+                 const SDL_Rect * srcrect, const SDL_Rect * final_rect,
+                 const double angle, const SDL_RendererFlip flip, SDL_bool applyModulation, SDL_bool isOpaque)
 {
     SDL_Surface *src = (SDL_Surface *) texture->driverdata;
     SDL_Rect tmp_rect;
-    SDL_Surface *src_clone, *src_rotated, *src_scaled;
+    SDL_Surface *src_clone, *src_rotated = NULL, *src_scaled;
     SDL_Surface *mask = NULL, *mask_rotated = NULL;
-    int retval = 0, dstwidth, dstheight, abscenterx, abscentery;
-    double cangle, sangle, px, py, p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y;
+    int retval = 0, dstwidth, dstheight;
+    double cangle, sangle;
     SDL_BlendMode blendmode;
     Uint8 alphaMod, rMod, gMod, bMod;
-    int applyModulation = SDL_FALSE;
     int blitRequired = SDL_FALSE;
-    int isOpaque = SDL_FALSE;
-
-    if (!surface) {
-        return -1;
-    }
 
     tmp_rect.x = 0;
     tmp_rect.y = 0;
@@ -399,17 +502,11 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
     }
 
     /* The color and alpha modulation has to be applied before the rotation when using the NONE, MOD or MUL blend modes. */
-    if ((blendmode == SDL_BLENDMODE_NONE || blendmode == SDL_BLENDMODE_MOD || blendmode == SDL_BLENDMODE_MUL) && (alphaMod & rMod & gMod & bMod) != 255) {
-        applyModulation = SDL_TRUE;
+    if (applyModulation) {
         SDL_SetSurfaceAlphaMod(src_clone, alphaMod);
         SDL_SetSurfaceColorMod(src_clone, rMod, gMod, bMod);
     }
 
-    /* Opaque surfaces are much easier to handle with the NONE blend mode. */
-    if (blendmode == SDL_BLENDMODE_NONE && !src->format->Amask && alphaMod == 255) {
-        isOpaque = SDL_TRUE;
-    }
-
     /* The NONE blend mode requires a mask for non-opaque surfaces. This mask will be used
      * to clear the pixels in the destination surface. The other steps are explained below.
      */
@@ -457,95 +554,6 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
                 retval = -1;
             }
         }
-        if (!retval) {
-            /* Find out where the new origin is by rotating the four final_rect points around the center and then taking the extremes */
-            abscenterx = final_rect->x + (int)center->x;
-            abscentery = final_rect->y + (int)center->y;
-            /* Compensate the angle inversion to match the behaviour of the other backends */
-            sangle = -sangle;
-
-            /* Top Left */
-            px = final_rect->x - abscenterx;
-            py = final_rect->y - abscentery;
-            p1x = px * cangle - py * sangle + abscenterx;
-            p1y = px * sangle + py * cangle + abscentery;
-
-            /* Top Right */
-            px = final_rect->x + final_rect->w - abscenterx;
-            py = final_rect->y - abscentery;
-            p2x = px * cangle - py * sangle + abscenterx;
-            p2y = px * sangle + py * cangle + abscentery;
-
-            /* Bottom Left */
-            px = final_rect->x - abscenterx;
-            py = final_rect->y + final_rect->h - abscentery;
-            p3x = px * cangle - py * sangle + abscenterx;
-            p3y = px * sangle + py * cangle + abscentery;
-
-            /* Bottom Right */
-            px = final_rect->x + final_rect->w - abscenterx;
-            py = final_rect->y + final_rect->h - abscentery;
-            p4x = px * cangle - py * sangle + abscenterx;
-            p4y = px * sangle + py * cangle + abscentery;
-
-            tmp_rect.x = (int)MIN(MIN(p1x, p2x), MIN(p3x, p4x));
-            tmp_rect.y = (int)MIN(MIN(p1y, p2y), MIN(p3y, p4y));
-            tmp_rect.w = dstwidth;
-            tmp_rect.h = dstheight;
-
-            /* The NONE blend mode needs some special care with non-opaque surfaces.
-             * Other blend modes or opaque surfaces can be blitted directly.
-             */
-            if (blendmode != SDL_BLENDMODE_NONE || isOpaque) {
-                if (applyModulation == SDL_FALSE) {
-                    /* If the modulation wasn't already applied, make it happen now. */
-                    SDL_SetSurfaceAlphaMod(src_rotated, alphaMod);
-                    SDL_SetSurfaceColorMod(src_rotated, rMod, gMod, bMod);
-                }
-                retval = SDL_BlitSurface(src_rotated, NULL, surface, &tmp_rect);
-            } else {
-                /* The NONE blend mode requires three steps to get the pixels onto the destination surface.
-                 * First, the area where the rotated pixels will be blitted to get set to zero.
-                 * This is accomplished by simply blitting a mask with the NONE blend mode.
-                 * The colorkey set by the rotate function will discard the correct pixels.
-                 */
-                SDL_Rect mask_rect = tmp_rect;
-                SDL_SetSurfaceBlendMode(mask_rotated, SDL_BLENDMODE_NONE);
-                retval = SDL_BlitSurface(mask_rotated, NULL, surface, &mask_rect);
-                if (!retval) {
-                    /* The next step copies the alpha value. This is done with the BLEND blend mode and
-                     * by modulating the source colors with 0. Since the destination is all zeros, this
-                     * will effectively set the destination alpha to the source alpha.
-                     */
-                    SDL_SetSurfaceColorMod(src_rotated, 0, 0, 0);
-                    mask_rect = tmp_rect;
-                    retval = SDL_BlitSurface(src_rotated, NULL, surface, &mask_rect);
-                    if (!retval) {
-                        /* The last step gets the color values in place. The ADD blend mode simply adds them to
-                         * the destination (where the color values are all zero). However, because the ADD blend
-                         * mode modulates the colors with the alpha channel, a surface without an alpha mask needs
-                         * to be created. This makes all source pixels opaque and the colors get copied correctly.
-                         */
-                        SDL_Surface *src_rotated_rgb;
-                        src_rotated_rgb = SDL_CreateRGBSurfaceFrom(src_rotated->pixels, src_rotated->w, src_rotated->h,
-                                                                   src_rotated->format->BitsPerPixel, src_rotated->pitch,
-                                                                   src_rotated->format->Rmask, src_rotated->format->Gmask,
-                                                                   src_rotated->format->Bmask, 0);
-                        if (src_rotated_rgb == NULL) {
-                            retval = -1;
-                        } else {
-                            SDL_SetSurfaceBlendMode(src_rotated_rgb, SDL_BLENDMODE_ADD);
-                            retval = SDL_BlitSurface(src_rotated_rgb, NULL, surface, &tmp_rect);
-                            SDL_FreeSurface(src_rotated_rgb);
-                        }
-                    }
-                }
-                SDL_FreeSurface(mask_rotated);
-            }
-            if (src_rotated != NULL) {
-                SDL_FreeSurface(src_rotated);
-            }
-        }
     }
 
     if (SDL_MUSTLOCK(src)) {
@@ -557,9 +565,246 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * tex
     if (src_clone != NULL) {
         SDL_FreeSurface(src_clone);
     }
+    if (retval < 0) {
+        if (src_rotated != NULL) {
+            SDL_FreeSurface(src_rotated);
+        }
+        return retval;
+    }
+
+    entry->rotated = src_rotated;
+    entry->mask = mask_rotated;
+    entry->quarter_turn = (!blitRequired && !applyModulation && (int)(angle / 90) == angle / 90) ? SDL_TRUE : SDL_FALSE;
+    return 0;
+}
+
+/* Rotates the texture's new pixels into the surface of an out of date
+   quarter turn. The mask only depends on the geometry, so it stays.
+   Returns SDL_FALSE if the entry has to be rotated again from scratch. */
+static SDL_bool
+SW_RefreshRotation(SW_RotationCacheEntry *entry, SDL_Texture * texture)
+{
+    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+    const SW_RotationKey *key = &entry->key;
+    const int numClockwiseTurns = (int)(key->angle / 90);
+    const SDL_bool sideways = (numClockwiseTurns & 1) ? SDL_TRUE : SDL_FALSE;
+
+    /* Only whole, unscaled textures were rotated straight from their pixels */
+    if (!entry->quarter_turn ||
+        key->srcrect.x != 0 || key->srcrect.y != 0 ||
+        key->srcrect.w != src->w || key->srcrect.h != src->h ||
+        key->w != src->w || key->h != src->h ||
+        entry->rotated->format->format != src->format->format ||
+        entry->rotated->w != (sideways ? src->h : src->w) ||
+        entry->rotated->h != (sideways ? src->w : src->h)) {
+        return SDL_FALSE;
+    }
+    if (SDLgfx_rotateSurface90(src, entry->rotated, numClockwiseTurns, key->flip & SDL_FLIP_HORIZONTAL, key->flip & SDL_FLIP_VERTICAL) < 0) {
+        return SDL_FALSE;
+    }
+    entry->stale = SDL_FALSE;
+    return SDL_TRUE;
+}
+
+/* Returns the rotated copy of the texture, from the cache if it was drawn
+   the same way recently, otherwise replacing the least recently used one. */
+static SW_RotationCacheEntry *
+SW_GetRotation(SDL_Renderer * renderer, SDL_Texture * texture,
+               const SDL_Rect * srcrect, const SDL_Rect * final_rect,
+               const double angle, const SDL_RendererFlip flip, SDL_bool applyModulation, SDL_bool isOpaque)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+    SW_RotationCacheEntry *entry = NULL;
+    SW_RotationKey key;
+    int i;
+
+    SDL_zero(key);
+    key.texture = texture;
+    key.srcrect = *srcrect;
+    key.w = final_rect->w;
+    key.h = final_rect->h;
+    key.angle = angle;
+    key.flip = flip;
+    key.scaleMode = texture->scaleMode;
+    SDL_GetSurfaceBlendMode(src, &key.blendMode);
+    SDL_GetSurfaceColorMod(src, &key.r, &key.g, &key.b);
+    SDL_GetSurfaceAlphaMod(src, &key.a);
+
+    ++data->rotation_clock;
+    for (i = 0; i < SDL_arraysize(data->rotations); ++i) {
+        SW_RotationCacheEntry *candidate = &data->rotations[i];
+        if (candidate->rotated && SDL_memcmp(&candidate->key, &key, sizeof(key)) == 0) {
+            if (candidate->stale && !SW_RefreshRotation(candidate, texture)) {
+                /* Rotate it again from scratch */
+                entry = candidate;
+                break;
+            }
+            candidate->last_used = data->rotation_clock;
+            return candidate;
+        }
+        if (!entry || !candidate->rotated ||
+            (entry->rotated && candidate->last_used < entry->last_used)) {
+            entry = candidate;
+        }
+    }
+
+    SW_FreeRotation(entry);
+    if (SW_RotateTexture(entry, texture, srcrect, final_rect, angle, flip, applyModulation, isOpaque) < 0) {
+        return NULL;
+    }
+    SDL_memcpy(&entry->key, &key, sizeof(key));
+    entry->last_used = data->rotation_clock;
+    return entry;
+}
+
+static int
+SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Surface *surface, SDL_Texture * texture,
+                const SDL_Rect * srcrect, const SDL_Rect * final_rect,
+                const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip)
+{
+    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+    SW_RotationCacheEntry *rotation;
+    SDL_Rect tmp_rect;
+    SDL_Surface *src_rotated, *mask_rotated;
+    int retval = 0, dstwidth, dstheight, abscenterx, abscentery;
+    double cangle, sangle, px, py, p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y;
+    SDL_BlendMode blendmode;
+    Uint8 alphaMod, rMod, gMod, bMod;
+    int applyModulation = SDL_FALSE;
+    int isOpaque = SDL_FALSE;
+
+    if (!surface) {
+        return -1;
+    }
+
+    SDL_GetSurfaceBlendMode(src, &blendmode);
+    SDL_GetSurfaceAlphaMod(src, &alphaMod);
+    SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+
+    /* The color and alpha modulation has to be applied before the rotation when using the NONE, MOD or MUL blend modes. */
+    if ((blendmode == SDL_BLENDMODE_NONE || blendmode == SDL_BLENDMODE_MOD || blendmode == SDL_BLENDMODE_MUL) && (alphaMod & rMod & gMod & bMod) != 255) {
+        applyModulation = SDL_TRUE;
+    }
+
+    /* Opaque surfaces are much easier to handle with the NONE blend mode. */
+    if (blendmode == SDL_BLENDMODE_NONE && !src->format->Amask && alphaMod == 255) {
+        isOpaque = SDL_TRUE;
+    }
+
+    rotation = SW_GetRotation(renderer, texture, srcrect, final_rect, angle, flip, applyModulation, isOpaque);
+    if (rotation == NULL) {
+        return -1;
+    }
+    src_rotated = rotation->rotated;
+    mask_rotated = rotation->mask;
+
+    SDLgfx_rotozoomSurfaceSizeTrig(final_rect->w, final_rect->h, angle, &dstwidth, &dstheight, &cangle, &sangle);
+
+    /* Find out where the new origin is by rotating the four final_rect points around the center and then taking the extremes */
+    abscenterx = final_rect->x + (int)center->x;
+    abscentery = final_rect->y + (int)center->y;
+    /* Compensate the angle inversion to match the behaviour of the other backends */
+    sangle = -sangle;
+
+    /* Top Left */
+    px = final_rect->x - abscenterx;
+    py = final_rect->y - abscentery;
+    p1x = px * cangle - py * sangle + abscenterx;
+    p1y = px * sangle + py * cangle + abscentery;
+
+    /* Top Right */
+    px = final_rect->x + final_rect->w - abscenterx;
+    py = final_rect->y - abscentery;
+    p2x = px * cangle - py * sangle + abscenterx;
+    p2y = px * sangle + py * cangle + abscentery;
+
+    /* Bottom Left */
+    px = final_rect->x - abscenterx;
+    py = final_rect->y + final_rect->h - abscentery;
+    p3x = px * cangle - py * sangle + abscenterx;
+    p3y = px * sangle + py * cangle + abscentery;
+
+    /* Bottom Right */
+    px = final_rect->x + final_rect->w - abscenterx;
+    py = final_rect->y + final_rect->h - abscentery;
+    p4x = px * cangle - py * sangle + abscenterx;
+    p4y = px * sangle + py * cangle + abscentery;
+
+    tmp_rect.x = (int)MIN(MIN(p1x, p2x), MIN(p3x, p4x));
+    tmp_rect.y = (int)MIN(MIN(p1y, p2y), MIN(p3y, p4y));
+    tmp_rect.w = dstwidth;
+    tmp_rect.h = dstheight;
+
+    /* The NONE blend mode needs some special care with non-opaque surfaces.
+     * Other blend modes or opaque surfaces can be blitted directly.
+     */
+    if (blendmode != SDL_BLENDMODE_NONE || isOpaque) {
+        if (applyModulation == SDL_FALSE) {
+            /* If the modulation wasn't already applied, make it happen now. */
+            SDL_SetSurfaceAlphaMod(src_rotated, alphaMod);
+            SDL_SetSurfaceColorMod(src_rotated, rMod, gMod, bMod);
+        }
+        retval = SDL_BlitSurface(src_rotated, NULL, surface, &tmp_rect);
+    } else {
+        /* The NONE blend mode requires three steps to get the pixels onto the destination surface.
+         * First, the area where the rotated pixels will be blitted to get set to zero.
+         * This is accomplished by simply blitting a mask with the NONE blend mode.
+         * The colorkey set by the rotate function will discard the correct pixels.
+         */
+        SDL_Rect mask_rect = tmp_rect;
+        SDL_SetSurfaceBlendMode(mask_rotated, SDL_BLENDMODE_NONE);
+        retval = SDL_BlitSurface(mask_rotated, NULL, surface, &mask_rect);
+        if (!retval) {
+            /* The next step copies the alpha value. This is done with the BLEND blend mode and
+             * by modulating the source colors with 0. Since the destination is all zeros, this
+             * will effectively set the destination alpha to the source alpha.
+             */
+            SDL_SetSurfaceColorMod(src_rotated, 0, 0, 0);
+            mask_rect = tmp_rect;
+            retval = SDL_BlitSurface(src_rotated, NULL, surface, &mask_rect);
+            if (!retval) {
+                /* The last step gets the color values in place. The ADD blend mode simply adds them to
+                 * the destination (where the color values are all zero). However, because the ADD blend
+                 * mode modulates the colors with the alpha channel, a surface without an alpha mask needs
+                 * to be created. This makes all source pixels opaque and the colors get copied correctly.
+                 */
+                SDL_Surface *src_rotated_rgb;
+                src_rotated_rgb = SDL_CreateRGBSurfaceFrom(src_rotated->pixels, src_rotated->w, src_rotated->h,
+                                                           src_rotated->format->BitsPerPixel, src_rotated->pitch,
+                                                           src_rotated->format->Rmask, src_rotated->format->Gmask,
+                                                           src_rotated->format->Bmask, 0);
+                if (src_rotated_rgb == NULL) {
+                    retval = -1;
+                } else {
+                    SDL_SetSurfaceBlendMode(src_rotated_rgb, SDL_BLENDMODE_ADD);
+                    retval = SDL_BlitSurface(src_rotated_rgb, NULL, surface, &tmp_rect);
+                    SDL_FreeSurface(src_rotated_rgb);
+                }
+            }
+        }
+    }
     return retval;
 }
 
+/* A rectangle the rotated copy is sure to stay inside: the square around
+   the circle that the corners of dstrect sweep around the center. */
+static void
+SW_GetCopyExBounds(const CopyExData *copydata, SDL_Rect *bounds)
+{
+    const SDL_Rect *dstrect = &copydata->dstrect;
+    const double cx = copydata->center.x;
+    const double cy = copydata->center.y;
+    const double dx = SDL_max(cx, dstrect->w - cx);
+    const double dy = SDL_max(cy, dstrect->h - cy);
+    const int radius = (int)SDL_ceil(SDL_sqrt(dx * dx + dy * dy)) + 1;
+
+    bounds->x = dstrect->x + (int)cx - radius;
+    bounds->y = dstrect->y + (int)cy - radius;
+    bounds->w = 2 * radius + 1;
+    bounds->h = 2 * radius + 1;
+}
+
 static void
 PrepTextureForCopy(const SDL_RenderCommand *cmd)
 {
@@ -572,7 +817,7 @@ PrepTextureForCopy(const SDL_RenderCommand *cmd)
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
     const SDL_bool colormod = ((r & g & b) != 0xFF);
     const SDL_bool alphamod = (a != 0xFF);
-    const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL));
+    const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL) || (blend == SDL_BLENDMODE_BLEND_PREMULTIPLIED));
 
     if (colormod || alphamod || blending) {
         SDL_SetSurfaceRLE(surface, 0);
@@ -610,8 +855,11 @@ SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
 static int
 SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SW_DrawStateCache drawstate;
+    SDL_Rect bounds;
+    int i;
 
     if (!surface) {
         return -1;
@@ -647,6 +895,7 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 /* By definition the clear ignores the clip rect */
                 SDL_SetClipRect(surface, NULL);
                 SDL_FillRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
+                SW_AddDamage(data, surface, &surface->clip_rect);
                 drawstate.surface_cliprect_dirty = SDL_TRUE;
                 break;
             }
@@ -660,6 +909,9 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 const SDL_BlendMode blend = cmd->data.draw.blend;
                 SetDrawState(surface, &drawstate);
+                if (SDL_EnclosePoints(verts, count, NULL, &bounds)) {
+                    SW_AddDamage(data, surface, &bounds);
+                }
                 if (blend == SDL_BLENDMODE_NONE) {
                     SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
                 } else {
@@ -677,6 +929,9 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const SDL_Point *verts = (SDL_Point *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 const SDL_BlendMode blend = cmd->data.draw.blend;
                 SetDrawState(surface, &drawstate);
+                if (SDL_EnclosePoints(verts, count, NULL, &bounds)) {
+                    SW_AddDamage(data, surface, &bounds);
+                }
                 if (blend == SDL_BLENDMODE_NONE) {
                     SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
                 } else {
@@ -694,6 +949,9 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 const SDL_Rect *verts = (SDL_Rect *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 const SDL_BlendMode blend = cmd->data.draw.blend;
                 SetDrawState(surface, &drawstate);
+                for (i = 0; i < count; ++i) {
+                    SW_AddDamage(data, surface, &verts[i]);
+                }
                 if (blend == SDL_BLENDMODE_NONE) {
                     SDL_FillRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
                 } else {
@@ -710,6 +968,7 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
                 SDL_Surface *src = (SDL_Surface *) texture->driverdata;
 
                 SetDrawState(surface, &drawstate);
+                SW_AddDamage(data, surface, dstrect);
 
                 PrepTextureForCopy(cmd);
 
@@ -728,6 +987,8 @@ SW_RunCommandQueue(SDL_Renderer * renderer, SDL_RenderCommand *cmd, void *vertic
             case SDL_RENDERCMD_COPY_EX: {
                 const CopyExData *copydata = (CopyExData *) (((Uint8 *) vertices) + cmd->data.draw.first);
                 SetDrawState(surface, &drawstate);
+                SW_GetCopyExBounds(copydata, &bounds);
+                SW_AddDamage(data, surface, &bounds);
                 PrepTextureForCopy(cmd);
                 SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
                                 &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip);
@@ -778,11 +1039,19 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
 static void
 SW_RenderPresent(SDL_Renderer * renderer)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Window *window = renderer->window;
 
     if (window) {
-        SDL_UpdateWindowSurface(window);
+        /* Only send the part of the window that was drawn to */
+        if (data->damage_all) {
+            SDL_UpdateWindowSurface(window);
+        } else if (!SDL_RectEmpty(&data->damage)) {
+            SDL_UpdateWindowSurfaceRects(window, &data->damage, 1);
+        }
     }
+    data->damage_all = SDL_FALSE;
+    SDL_zero(data->damage);
 }
 
 static void
@@ -790,6 +1059,7 @@ SW_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
 
+    SW_FreeRotations(renderer, texture);
     SDL_FreeSurface(surface);
 }
 
@@ -798,6 +1068,9 @@ SW_DestroyRenderer(SDL_Renderer * renderer)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
+    if (data) {
+        SW_FreeRotations(renderer, NULL);
+    }
     SDL_free(data);
     SDL_free(renderer);
 }
@@ -827,9 +1100,11 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     }
     data->surface = surface;
     data->window = surface;
+    data->damage_all = SDL_TRUE;
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
+    renderer->SupportsBlendMode = SW_SupportsBlendMode;
     renderer->CreateTexture = SW_CreateTexture;
     renderer->UpdateTexture = SW_UpdateTexture;
     renderer->LockTexture = SW_LockTexture;
@@ -174,37 +174,129 @@ computeSourceIncrements90(SDL_Surface * src, int bpp, int angle, int flipx, int
     }
 }
 
-/* Performs a relatively fast rotation/flip when the angle is a multiple of 90 degrees. */
-#define TRANSFORM_SURFACE_90(pixelType) \
-    int dy, dincy = dst->pitch - dst->w*sizeof(pixelType), sincx, sincy, signx, signy;                      \
-    Uint8 *sp = (Uint8*)src->pixels, *dp = (Uint8*)dst->pixels, *de;                                        \
+/* Side of the square tiles 90 and 270 degree rotations are done in, so that
+   the source columns being read stay in the cache until they're used up. */
+#define TRANSFORM_TILE_SIZE 16
+
+/* Copies a tile of w x h pixels, the source moving by sincx bytes for each
+   destination pixel and by sincy bytes for each destination row. */
+#define TRANSFORM_TILE_90(pixelType, sp, sincx, sincy, dp, dpitch, x0, y0, w, h)    \
+    {                                                                               \
+        int tx, ty;                                                                 \
+        for (ty = y0; ty < h; ++ty) {                                               \
+            const Uint8 *tsp = sp + ty * sincy + x0 * sincx;                        \
+            pixelType *tdp = (pixelType *)(dp + ty * dpitch) + x0;                  \
+            for (tx = x0; tx < w; ++tx, tsp += sincx) {                             \
+                *tdp++ = *(const pixelType *)tsp;                                   \
+            }                                                                       \
+        }                                                                           \
+    }
+
+#if defined(__SSE2__)
+/* Transposes the tile in blocks of 4x4 pixels, with sincy being one pixel
+   either way, so that each block is 4 loads and 4 stores. */
+static void
+transformTileRGBA90SSE2(const Uint8 *sp, int sincx, int sincy, Uint8 *dp, int dpitch, int w, int h)
+{
+    const Uint8 *rowp;
+    __m128i r0, r1, r2, r3, t0, t1, t2, t3;
+    int x, y;
+
+    for (y = 0; y + 4 <= h; y += 4) {
+        for (x = 0; x + 4 <= w; x += 4) {
+            /* Each of these holds one destination column of the block */
+            rowp = sp + y * sincy + x * sincx;
+            if (sincy < 0) {
+                rowp -= 3 * sizeof(tColorRGBA);
+            }
+            r0 = _mm_loadu_si128((const __m128i *)rowp);
+            r1 = _mm_loadu_si128((const __m128i *)(rowp + sincx));
+            r2 = _mm_loadu_si128((const __m128i *)(rowp + 2 * sincx));
+            r3 = _mm_loadu_si128((const __m128i *)(rowp + 3 * sincx));
+            if (sincy < 0) {
+                r0 = _mm_shuffle_epi32(r0, _MM_SHUFFLE(0, 1, 2, 3));
+                r1 = _mm_shuffle_epi32(r1, _MM_SHUFFLE(0, 1, 2, 3));
+                r2 = _mm_shuffle_epi32(r2, _MM_SHUFFLE(0, 1, 2, 3));
+                r3 = _mm_shuffle_epi32(r3, _MM_SHUFFLE(0, 1, 2, 3));
+            }
+            t0 = _mm_unpacklo_epi32(r0, r1);
+            t1 = _mm_unpacklo_epi32(r2, r3);
+            t2 = _mm_unpackhi_epi32(r0, r1);
+            t3 = _mm_unpackhi_epi32(r2, r3);
+            _mm_storeu_si128((__m128i *)(dp + y * dpitch) + x / 4, _mm_unpacklo_epi64(t0, t1));
+            _mm_storeu_si128((__m128i *)(dp + (y + 1) * dpitch) + x / 4, _mm_unpackhi_epi64(t0, t1));
+            _mm_storeu_si128((__m128i *)(dp + (y + 2) * dpitch) + x / 4, _mm_unpacklo_epi64(t2, t3));
+            _mm_storeu_si128((__m128i *)(dp + (y + 3) * dpitch) + x / 4, _mm_unpackhi_epi64(t2, t3));
+        }
+    }
+
+    /* The right and bottom edges that don't make up a whole block */
+    TRANSFORM_TILE_90(tColorRGBA, sp, sincx, sincy, dp, dpitch, (w & ~3), 0, w, (h & ~3));
+    TRANSFORM_TILE_90(tColorRGBA, sp, sincx, sincy, dp, dpitch, 0, (h & ~3), w, h);
+}
+#endif /* __SSE2__ */
+
+/* Performs a relatively fast rotation/flip when the angle is a multiple of 90 degrees.
+
+   When the source rows map to destination rows (0 and 180 degrees) they are
+   copied one after the other. Otherwise the destination is walked in tiles,
+   reading a few source columns at a time instead of one pixel per row. */
+#define TRANSFORM_SURFACE_90(pixelType, transformTile)                                                      \
+    int dx, dy, sincx, sincy, signx, signy;                                                                 \
+    const int dw = dst->w, dh = dst->h, dpitch = dst->pitch;                                                \
+    Uint8 *sp = (Uint8*)src->pixels, *dp = (Uint8*)dst->pixels;                                             \
                                                                                                             \
     computeSourceIncrements90(src, sizeof(pixelType), angle, flipx, flipy, &sincx, &sincy, &signx, &signy); \
     if (signx < 0) sp += (src->w-1)*sizeof(pixelType);                                                      \
     if (signy < 0) sp += (src->h-1)*src->pitch;                                                             \
+    sincy += dw * sincx; /* from one destination row to the next, rather than from the end of a row */      \
                                                                                                             \
-    for (dy = 0; dy < dst->h; sp += sincy, dp += dincy, dy++) {                                             \
-        if (sincx == sizeof(pixelType)) { /* if advancing src and dest equally, use memcpy */               \
-            SDL_memcpy(dp, sp, dst->w*sizeof(pixelType));                                                   \
-            sp += dst->w*sizeof(pixelType);                                                                 \
-            dp += dst->w*sizeof(pixelType);                                                                 \
-        } else {                                                                                            \
-            for (de = dp + dst->w*sizeof(pixelType); dp != de; sp += sincx, dp += sizeof(pixelType)) {      \
-                *(pixelType*)dp = *(pixelType*)sp;                                                          \
+    if (sincx == sizeof(pixelType)) { /* if advancing src and dest equally, use memcpy */                   \
+        for (dy = 0; dy < dh; sp += sincy, dp += dpitch, dy++) {                                            \
+            SDL_memcpy(dp, sp, dw*sizeof(pixelType));                                                       \
+        }                                                                                                   \
+    } else if (sincx == -(int)sizeof(pixelType)) {                                                          \
+        TRANSFORM_TILE_90(pixelType, sp, sincx, sincy, dp, dpitch, 0, 0, dw, dh);                           \
+    } else {                                                                                                \
+        for (dy = 0; dy < dh; dy += TRANSFORM_TILE_SIZE) {                                                  \
+            for (dx = 0; dx < dw; dx += TRANSFORM_TILE_SIZE) {                                              \
+                transformTile(sp + dy * sincy + dx * sincx, sincx, sincy,                                   \
+                              dp + dy * dpitch + dx * sizeof(pixelType), dpitch,                            \
+                              MIN(TRANSFORM_TILE_SIZE, dw - dx), MIN(TRANSFORM_TILE_SIZE, dh - dy));        \
             }                                                                                               \
         }                                                                                                   \
     }
 
+static void
+transformTileRGBA90(const Uint8 *sp, int sincx, int sincy, Uint8 *dp, int dpitch, int w, int h)
+{
+    TRANSFORM_TILE_90(tColorRGBA, sp, sincx, sincy, dp, dpitch, 0, 0, w, h);
+}
+
+static void
+transformTileY90(const Uint8 *sp, int sincx, int sincy, Uint8 *dp, int dpitch, int w, int h)
+{
+    TRANSFORM_TILE_90(tColorY, sp, sincx, sincy, dp, dpitch, 0, 0, w, h);
+}
+
 static void
 transformSurfaceRGBA90(SDL_Surface * src, SDL_Surface * dst, int angle, int flipx, int flipy)
 {
-    TRANSFORM_SURFACE_90(tColorRGBA);
+#if defined(__SSE2__)
+    if (SDL_HasSSE2()) {
+        TRANSFORM_SURFACE_90(tColorRGBA, transformTileRGBA90SSE2);
+        return;
+    }
+#endif
+    {
+        TRANSFORM_SURFACE_90(tColorRGBA, transformTileRGBA90);
+    }
 }
 
 static void
 transformSurfaceY90(SDL_Surface * src, SDL_Surface * dst, int angle, int flipx, int flipy)
 {
-    TRANSFORM_SURFACE_90(tColorY);
+    TRANSFORM_SURFACE_90(tColorY, transformTileY90);
 }
 
 #undef TRANSFORM_SURFACE_90
@@ -386,6 +478,69 @@ transformSurfaceY(SDL_Surface * src, SDL_Surface * dst, int cx, int cy, int isin
 }
 
 
+/* !
+\brief Rotates a surface by a multiple of 90 degrees into an existing surface.
+
+Unlike SDLgfx_rotateSurface, this doesn't allocate anything, so a caller that
+rotates the same way repeatedly can keep reusing its destination surface.
+Both surfaces must have the same format, either 8 or 32 bits per pixel, and
+'dst' must have the rotated size of 'src'. Blend mode and colorkey are left
+alone.
+
+\param src The surface to rotate.
+\param dst The surface receiving the rotated pixels.
+\param angle90 The number of clockwise quarter turns, may be negative.
+\param flipx Set to 1 to flip the image horizontally
+\param flipy Set to 1 to flip the image vertically
+\return 0 on success or -1 if the surfaces don't fit.
+
+*/
+int
+SDLgfx_rotateSurface90(SDL_Surface * src, SDL_Surface * dst, int angle90, int flipx, int flipy)
+{
+    int dstwidth, dstheight;
+
+    if (src == NULL) {
+        return SDL_InvalidParamError("src");
+    }
+    if (dst == NULL) {
+        return SDL_InvalidParamError("dst");
+    }
+    if (src->format->format != dst->format->format ||
+        (src->format->BitsPerPixel != 8 && src->format->BitsPerPixel != 32)) {
+        return SDL_SetError("Surfaces must have the same 8 or 32-bit pixel format");
+    }
+
+    angle90 %= 4;
+    if (angle90 < 0) angle90 += 4; /* 0:0 deg, 1:90 deg, 2:180 deg, 3:270 deg */
+    dstwidth = (angle90 & 1) ? src->h : src->w;
+    dstheight = (angle90 & 1) ? src->w : src->h;
+    if (dst->w != dstwidth || dst->h != dstheight) {
+        return SDL_SetError("Destination surface must be %dx%d", dstwidth, dstheight);
+    }
+
+    if (SDL_MUSTLOCK(src)) {
+        SDL_LockSurface(src);
+    }
+    if (SDL_MUSTLOCK(dst)) {
+        SDL_LockSurface(dst);
+    }
+
+    if (src->format->BitsPerPixel == 8) {
+        transformSurfaceY90(src, dst, angle90, flipx, flipy);
+    } else {
+        transformSurfaceRGBA90(src, dst, angle90, flipx, flipy);
+    }
+
+    if (SDL_MUSTLOCK(dst)) {
+        SDL_UnlockSurface(dst);
+    }
+    if (SDL_MUSTLOCK(src)) {
+        SDL_UnlockSurface(src);
+    }
+    return 0;
+}
+
 /* !
 \brief Rotates and zooms a surface with different horizontal and vertival scaling factors and optional anti-aliasing.
 
@@ -27,6 +27,7 @@
 #endif
 
 extern SDL_Surface *SDLgfx_rotateSurface(SDL_Surface * src, double angle, int centerx, int centery, int smooth, int flipx, int flipy, int dstwidth, int dstheight, double cangle, double sangle);
+extern int SDLgfx_rotateSurface90(SDL_Surface * src, SDL_Surface * dst, int angle90, int flipx, int flipy);
 extern void SDLgfx_rotozoomSurfaceSizeTrig(int width, int height, double angle, int *dstwidth, int *dstheight, double *cangle, double *sangle);
 
 #endif /* SDL_rotate_h_ */
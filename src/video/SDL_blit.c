@@ -28,6 +28,51 @@
 #include "SDL_blit_slow.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "SDL_parallel_c.h"
+
+/* Blits smaller than this always run on the calling thread, and bigger
+   ones are never split into bands smaller than half of it */
+#define PARALLEL_BLIT_MIN_PIXELS    (512 * 512)
+
+typedef struct
+{
+    SDL_BlitFunc blit;
+    SDL_BlitInfo info;
+} SDL_BlitRowBandData;
+
+static void
+SDL_BlitRowBand(void *data, int row_begin, int row_end)
+{
+    const SDL_BlitRowBandData *band = (const SDL_BlitRowBandData *) data;
+    SDL_BlitInfo info = band->info;
+
+    /* The blitters advance their own copy of the blit info */
+    info.src += row_begin * info.src_pitch;
+    info.dst += row_begin * info.dst_pitch;
+    info.src_h = row_end - row_begin;
+    info.dst_h = row_end - row_begin;
+    band->blit(&info);
+}
+
+/* An unscaled blit gives the same result when it runs in bands of rows,
+   as long as the source and destination pixels don't overlap */
+static SDL_bool
+SDL_CanSplitBlit(const SDL_BlitInfo * info)
+{
+    const Uint8 *src_end = info->src + (size_t)info->src_h * info->src_pitch;
+    const Uint8 *dst_end = info->dst + (size_t)info->dst_h * info->dst_pitch;
+
+    if (info->src_w != info->dst_w || info->src_h != info->dst_h) {
+        return SDL_FALSE;
+    }
+    if (info->dst_w * info->dst_h < PARALLEL_BLIT_MIN_PIXELS) {
+        return SDL_FALSE;
+    }
+    if (info->src < dst_end && info->dst < src_end) {
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
 
 /* The general purpose software blit routine */
 static int SDLCALL
@@ -85,7 +130,15 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
         RunBlit = (SDL_BlitFunc) src->map->data;
 
         /* Run the actual software blit */
-        RunBlit(info);
+        if (SDL_CanSplitBlit(info)) {
+            SDL_BlitRowBandData band;
+
+            band.blit = RunBlit;
+            band.info = *info;
+            SDL_ParallelRows(info->dst_h, 1, PARALLEL_BLIT_MIN_PIXELS / 2 / info->dst_w + 1, SDL_BlitRowBand, &band);
+        } else {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -130,7 +183,7 @@ static SDL_BlitFunc
 SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
                    SDL_BlitFuncEntry * entries)
 {
-    int i, flagcheck = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_COLORKEY | SDL_COPY_NEAREST));
+    int i, flagcheck = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_COLORKEY | SDL_COPY_NEAREST));
     static int features = 0x7fffffff;
 
     /* Get the available CPU features */
@@ -248,7 +301,7 @@ SDL_CalculateBlit(SDL_Surface * surface)
     }
 #endif
 #if SDL_HAVE_BLIT_A
-    else if (map->info.flags & SDL_COPY_BLEND) {
+    else if (map->info.flags & (SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED)) {
         blit = SDL_CalculateBlitA(surface);
     }
 #endif
@@ -45,6 +45,7 @@ extern Uint8* SDL_expand_byte[9];
 #define SDL_COPY_MUL                0x00000080
 #define SDL_COPY_COLORKEY           0x00000100
 #define SDL_COPY_NEAREST            0x00000200
+#define SDL_COPY_BLEND_PREMULTIPLIED 0x00000400
 #define SDL_COPY_RLE_DESIRED        0x00001000
 #define SDL_COPY_RLE_COLORKEY       0x00002000
 #define SDL_COPY_RLE_ALPHAKEY       0x00004000
@@ -467,6 +468,16 @@ do {                                                                    \
 } while(0)
 
 
+/* Blend the RGBA values of two pixels, the source color is pre-multiplied */
+#define PREMULTIPLIED_ALPHA_BLEND_RGBA(sR, sG, sB, sA, dR, dG, dB, dA)  \
+do {                                                                    \
+    dR = SDL_min(sR+((255-sA)*dR)/255, 255);                            \
+    dG = SDL_min(sG+((255-sA)*dG)/255, 255);                            \
+    dB = SDL_min(sB+((255-sA)*dB)/255, 255);                            \
+    dA = sA+((255-sA)*dA)/255;                                          \
+} while(0)
+
+
 /* This is a very useful loop for optimizing blitters */
 #if defined(_MSC_VER) && (_MSC_VER == 1300)
 /* There's a bug in the Visual C++ 7 optimizer when compiling this code */
@@ -455,6 +455,583 @@ BlitRGBtoRGBPixelAlphaARMNEON(SDL_BlitInfo * info)
 }
 #endif
 
+/* One pixel of pre-multiplied alpha blending, the same as
+   PREMULTIPLIED_ALPHA_BLEND_RGBA() on all four channels at once */
+static SDL_INLINE Uint32
+BlendPremultipliedPixelAlpha(Uint32 s, Uint32 d, Uint32 ashift)
+{
+    const Uint32 inva = ((s >> ashift) & 0xFF) ^ 0xFF;
+    Uint32 d1 = (d & 0x00ff00ff) * inva;
+    Uint32 d2 = (d >> 8 & 0x00ff00ff) * inva;
+
+    /* x / 255 in each 16-bit half, exact for x <= 255 * 255 */
+    d1 = ((d1 + 0x00010001 + (d1 >> 8 & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    d2 = ((d2 + 0x00010001 + (d2 >> 8 & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    d1 += s & 0x00ff00ff;
+    d2 += s >> 8 & 0x00ff00ff;
+    /* saturate channels that went past 255 */
+    d1 |= (d1 >> 8 & 0x00010001) * 0xFF;
+    d2 |= (d2 >> 8 & 0x00010001) * 0xFF;
+    return (d1 & 0x00ff00ff) | (d2 & 0x00ff00ff) << 8;
+}
+
+#if SDL_SSE4_1_INTRINSICS
+/* These produce exactly the same pixels as the MMX blitters above and the
+   generic blitters below, so the result doesn't depend on the CPU. */
+
+/* One pixel of BlitRGBtoRGBPixelAlphaMMX() */
+static SDL_INLINE Uint32
+BlendRGBtoRGBPixelAlpha(Uint32 s, Uint32 d, Uint32 amask, Uint32 ashift)
+{
+    const Uint32 alpha = (s & amask) >> ashift;
+    Uint32 shift, result = 0;
+
+    if (alpha == 0) {
+        return d;
+    } else if (alpha == 0xFF) {
+        return s;
+    }
+    for (shift = 0; shift < 32; shift += 8) {
+        const Uint32 factor = (shift == ashift) ? 0xFF : alpha;
+        const Uint32 sc = (s >> shift) & 0xFF;
+        const Uint32 dc = (d >> shift) & 0xFF;
+        result |= (((sc * factor) >> 8) + ((dc * (alpha ^ 0xFF)) >> 8)) << shift;
+    }
+    return result;
+}
+
+/* One pixel of BlitRGBtoRGBSurfaceAlphaMMX(), chanalpha has the alpha in each color channel */
+static SDL_INLINE Uint32
+BlendRGBtoRGBSurfaceAlpha(Uint32 s, Uint32 d, Uint32 chanalpha, Uint32 dalpha)
+{
+    Uint32 shift, result = 0;
+
+    for (shift = 0; shift < 32; shift += 8) {
+        const int sc = (s >> shift) & 0xFF;
+        const int dc = (d >> shift) & 0xFF;
+        const int ac = (chanalpha >> shift) & 0xFF;
+        result |= ((dc + ((((sc - dc) * ac) & 0xFFFF) >> 8)) & 0xFF) << shift;
+    }
+    return result | dalpha;
+}
+
+/* One pixel of BlitARGBto565PixelAlpha() */
+static SDL_INLINE Uint16
+BlendARGBto565PixelAlpha(Uint32 s, Uint16 dst)
+{
+    const Uint32 alpha = s >> 27;
+    Uint32 d = dst;
+
+    if (alpha == 0) {
+        return dst;
+    } else if (alpha == (SDL_ALPHA_OPAQUE >> 3)) {
+        return (Uint16)((s >> 8 & 0xf800) + (s >> 5 & 0x7e0) + (s >> 3 & 0x1f));
+    }
+    s = ((s & 0xfc00) << 11) + (s >> 8 & 0xf800) + (s >> 3 & 0x1f);
+    d = (d | d << 16) & 0x07e0f81f;
+    d += (s - d) * alpha >> 5;
+    d &= 0x07e0f81f;
+    return (Uint16)(d | d >> 16);
+}
+
+/* Blends 16-bit channels the way BlitRGBtoRGBPixelAlphaMMX() does */
+#define PIXEL_ALPHA_BLEND_16(P, W, src16, dst16, alpha16) \
+    P##_add_epi16( \
+        P##_srli_epi16(P##_mullo_epi16(src16, P##_or_si##W(alpha16, src_mult)), 8), \
+        P##_srli_epi16(P##_mullo_epi16(dst16, P##_xor_si##W(alpha16, channel_mask)), 8))
+
+/* Converts to G0RAB65565 and blends the way BlitARGBto565PixelAlpha() does */
+#define ARGB_565_PIXEL_ALPHA_BLEND(P, W, s, d) \
+    { \
+        const __m##W##i alpha = P##_srli_epi32(s, 27); \
+        __m##W##i s1, d1, opaque; \
+        s1 = P##_add_epi32(P##_add_epi32( \
+                P##_slli_epi32(P##_and_si##W(s, P##_set1_epi32(0xfc00)), 11), \
+                P##_and_si##W(P##_srli_epi32(s, 8), P##_set1_epi32(0xf800))), \
+                P##_and_si##W(P##_srli_epi32(s, 3), P##_set1_epi32(0x1f))); \
+        d1 = P##_and_si##W(P##_or_si##W(d, P##_slli_epi32(d, 16)), mask565); \
+        d1 = P##_add_epi32(d1, P##_srli_epi32(P##_mullo_epi32(P##_sub_epi32(s1, d1), alpha), 5)); \
+        d1 = P##_and_si##W(d1, mask565); \
+        d1 = P##_or_si##W(d1, P##_srli_epi32(d1, 16)); \
+        opaque = P##_add_epi32(P##_add_epi32( \
+                P##_and_si##W(P##_srli_epi32(s, 8), P##_set1_epi32(0xf800)), \
+                P##_and_si##W(P##_srli_epi32(s, 5), P##_set1_epi32(0x7e0))), \
+                P##_and_si##W(P##_srli_epi32(s, 3), P##_set1_epi32(0x1f))); \
+        d1 = P##_blendv_epi8(d1, opaque, P##_cmpeq_epi32(alpha, P##_set1_epi32(SDL_ALPHA_OPAQUE >> 3))); \
+        d1 = P##_blendv_epi8(d1, d, P##_cmpeq_epi32(alpha, P##_setzero_si##W())); \
+        d = P##_and_si##W(d1, P##_set1_epi32(0xFFFF)); \
+    }
+
+/* Blends 16-bit channels with pre-multiplied alpha, without the final saturation */
+#define PREMULTIPLIED_ALPHA_BLEND_16(P, W, src16, dst16, alpha16) \
+    P##_add_epi16(src16, P##_srli_epi16(P##_add_epi16( \
+        P##_add_epi16(P##_mullo_epi16(dst16, P##_xor_si##W(alpha16, channel_mask)), one16), \
+        P##_srli_epi16(P##_mullo_epi16(dst16, P##_xor_si##W(alpha16, channel_mask)), 8)), 8))
+
+/* Shuffle masks broadcasting the alpha byte of pixels 0,1 or 2,3 to their 16-bit channels */
+#define ALPHA_TO_CHANNELS_MASK(apos, first) \
+    _mm_setr_epi8((first) * 4 + apos, -1, (first) * 4 + apos, -1, (first) * 4 + apos, -1, (first) * 4 + apos, -1, \
+                  (first) * 4 + 4 + apos, -1, (first) * 4 + 4 + apos, -1, (first) * 4 + 4 + apos, -1, (first) * 4 + 4 + apos, -1)
+
+static __m128i
+AlphaChannelMultiplier(Uint32 ashift)
+{
+    /* 0x00FF in the 16-bit channel holding the alpha */
+    const Uint64 mult = (Uint64)0xFF << (ashift * 2);
+    return _mm_set_epi32((int)(mult >> 32), (int)mult, (int)(mult >> 32), (int)mult);
+}
+
+/* fast ARGB888->(A)RGB888 blending with pixel alpha */
+static void SDL_TARGETING("sse4.1")
+BlitRGBtoRGBPixelAlphaSSE41(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *sf = info->src_fmt;
+    Uint32 amask = sf->Amask;
+    Uint32 ashift = sf->Ashift;
+    const int apos = ashift / 8;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mm_amask = _mm_set1_epi32(amask);
+    const __m128i channel_mask = _mm_set1_epi16(0xFF);
+    const __m128i src_mult = AlphaChannelMultiplier(ashift);
+    const __m128i alpha_lo = ALPHA_TO_CHANNELS_MASK(apos, 0);
+    const __m128i alpha_hi = ALPHA_TO_CHANNELS_MASK(apos, 2);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 4; n -= 4) {
+            const __m128i s = _mm_loadu_si128((const __m128i *) srcp);
+            const __m128i d = _mm_loadu_si128((const __m128i *) dstp);
+            const __m128i alpha = _mm_and_si128(s, mm_amask);
+            __m128i lo, hi, result;
+
+            lo = PIXEL_ALPHA_BLEND_16(_mm, 128, _mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), _mm_shuffle_epi8(s, alpha_lo));
+            hi = PIXEL_ALPHA_BLEND_16(_mm, 128, _mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), _mm_shuffle_epi8(s, alpha_hi));
+            result = _mm_packus_epi16(lo, hi);
+            result = _mm_blendv_epi8(result, s, _mm_cmpeq_epi32(alpha, mm_amask));
+            result = _mm_blendv_epi8(result, d, _mm_cmpeq_epi32(alpha, zero));
+            _mm_storeu_si128((__m128i *) dstp, result);
+            srcp += 4;
+            dstp += 4;
+        }
+        for (; n > 0; --n) {
+            *dstp = BlendRGBtoRGBPixelAlpha(*srcp, *dstp, amask, ashift);
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* ARGB888->(A)RGB888 blending with pixel alpha between different channel
+   orders, same result as BlitNtoNPixelAlpha() */
+static void SDL_TARGETING("sse4.1")
+BlitNtoNPixelAlphaSSE41(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *srcfmt = info->src_fmt;
+    SDL_PixelFormat *dstfmt = info->dst_fmt;
+    const int apos = srcfmt->Ashift / 8;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i src_amask = _mm_set1_epi32(srcfmt->Amask);
+    const __m128i dst_mask = _mm_set1_epi32(dstfmt->Rmask | dstfmt->Gmask | dstfmt->Bmask | dstfmt->Amask);
+    const __m128i alpha_lo = ALPHA_TO_CHANNELS_MASK(apos, 0);
+    const __m128i alpha_hi = ALPHA_TO_CHANNELS_MASK(apos, 2);
+    Uint8 swizzle_bytes[16];
+    Uint16 alpha_lane[8];
+    __m128i swizzle, dst_alpha;
+    unsigned sR, sG, sB, sA;
+    unsigned dR, dG, dB, dA;
+    Uint32 Pixel;
+    int i;
+
+    /* Shuffle mask moving the source channels to where they go in the destination */
+    for (i = 0; i < 16; i += 4) {
+        SDL_memset(&swizzle_bytes[i], 0x80, 4);
+        swizzle_bytes[i + dstfmt->Rshift / 8] = (Uint8)(i + srcfmt->Rshift / 8);
+        swizzle_bytes[i + dstfmt->Gshift / 8] = (Uint8)(i + srcfmt->Gshift / 8);
+        swizzle_bytes[i + dstfmt->Bshift / 8] = (Uint8)(i + srcfmt->Bshift / 8);
+        if (dstfmt->Amask) {
+            swizzle_bytes[i + dstfmt->Ashift / 8] = (Uint8)(i + apos);
+        }
+    }
+    swizzle = _mm_loadu_si128((const __m128i *) swizzle_bytes);
+
+    /* The destination alpha is blended as sA + dA - sA * dA / 255 */
+    for (i = 0; i < 8; ++i) {
+        alpha_lane[i] = (dstfmt->Amask && (i % 4) == (int)dstfmt->Ashift / 8) ? 0xFFFF : 0;
+    }
+    dst_alpha = _mm_loadu_si128((const __m128i *) alpha_lane);
+
+/* x / 255 for 0 <= x <= 255 * 255, rounded towards zero */
+#define DIV255(x) _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, one), _mm_srli_epi16(x, 8)), 8)
+#define BLEND_16(src16, dst16, alpha16, result) \
+    { \
+        const __m128i diff = _mm_sub_epi16(src16, dst16); \
+        const __m128i q = DIV255(_mm_mullo_epi16(_mm_abs_epi16(diff), alpha16)); \
+        const __m128i color = _mm_add_epi16(dst16, _mm_sign_epi16(q, diff)); \
+        const __m128i alpha = _mm_sub_epi16(_mm_add_epi16(alpha16, dst16), DIV255(_mm_mullo_epi16(alpha16, dst16))); \
+        result = _mm_blendv_epi8(color, alpha, dst_alpha); \
+    }
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 4; n -= 4) {
+            const __m128i s = _mm_loadu_si128((const __m128i *) srcp);
+            const __m128i d = _mm_loadu_si128((const __m128i *) dstp);
+            const __m128i swizzled = _mm_shuffle_epi8(s, swizzle);
+            __m128i lo, hi, result;
+
+            BLEND_16(_mm_unpacklo_epi8(swizzled, zero), _mm_unpacklo_epi8(d, zero), _mm_shuffle_epi8(s, alpha_lo), lo);
+            BLEND_16(_mm_unpackhi_epi8(swizzled, zero), _mm_unpackhi_epi8(d, zero), _mm_shuffle_epi8(s, alpha_hi), hi);
+            result = _mm_and_si128(_mm_packus_epi16(lo, hi), dst_mask);
+            result = _mm_blendv_epi8(result, d, _mm_cmpeq_epi32(_mm_and_si128(s, src_amask), zero));
+            _mm_storeu_si128((__m128i *) dstp, result);
+            srcp += 4;
+            dstp += 4;
+        }
+        for (; n > 0; --n) {
+            DISEMBLE_RGBA((Uint8 *) srcp, 4, srcfmt, Pixel, sR, sG, sB, sA);
+            if (sA) {
+                DISEMBLE_RGBA((Uint8 *) dstp, 4, dstfmt, Pixel, dR, dG, dB, dA);
+                ALPHA_BLEND_RGBA(sR, sG, sB, sA, dR, dG, dB, dA);
+                ASSEMBLE_RGBA((Uint8 *) dstp, 4, dstfmt, dR, dG, dB, dA);
+            }
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+#undef DIV255
+#undef BLEND_16
+}
+
+/* fast RGB888->(A)RGB888 blending with surface alpha */
+static void SDL_TARGETING("sse4.1")
+BlitRGBtoRGBSurfaceAlphaSSE41(SDL_BlitInfo * info)
+{
+    SDL_PixelFormat *df = info->dst_fmt;
+    unsigned alpha = info->a;
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    Uint32 dalpha = df->Amask;
+    const __m128i dsta = _mm_set1_epi32(dalpha);
+
+    if (alpha == 128 && (df->Rmask | df->Gmask | df->Bmask) == 0x00FFFFFF) {
+        /* Same as BlitRGBtoRGBSurfaceAlpha128MMX() */
+        const __m128i hmask = _mm_set1_epi32(0x00fefefe);
+        const __m128i lmask = _mm_set1_epi32(0x00010101);
+
+        while (height--) {
+            int n = width;
+
+            for (; n >= 4; n -= 4) {
+                const __m128i s = _mm_loadu_si128((const __m128i *) srcp);
+                const __m128i d = _mm_loadu_si128((const __m128i *) dstp);
+                __m128i result;
+
+                result = _mm_srli_epi32(_mm_add_epi32(_mm_and_si128(s, hmask), _mm_and_si128(d, hmask)), 1);
+                result = _mm_add_epi32(result, _mm_and_si128(_mm_and_si128(s, d), lmask));
+                _mm_storeu_si128((__m128i *) dstp, _mm_or_si128(result, dsta));
+                srcp += 4;
+                dstp += 4;
+            }
+            for (; n > 0; --n) {
+                Uint32 s = *srcp++;
+                Uint32 d = *dstp;
+                *dstp++ = ((((s & 0x00fefefe) + (d & 0x00fefefe)) >> 1)
+                           + (s & d & 0x00010101)) | dalpha;
+            }
+            srcp += srcskip;
+            dstp += dstskip;
+        }
+    } else {
+        const __m128i zero = _mm_setzero_si128();
+        Uint32 chanalpha;
+        __m128i mm_alpha;
+
+        chanalpha = alpha | (alpha << 8);
+        chanalpha = chanalpha | (chanalpha << 16);
+        chanalpha &= (0xff << df->Rshift) | (0xff << df->Gshift) | (0xff << df->Bshift);
+        mm_alpha = _mm_unpacklo_epi8(_mm_set1_epi32(chanalpha), zero);
+
+        while (height--) {
+            int n = width;
+
+            for (; n >= 4; n -= 4) {
+                const __m128i s = _mm_loadu_si128((const __m128i *) srcp);
+                const __m128i d = _mm_loadu_si128((const __m128i *) dstp);
+                const __m128i d_lo = _mm_unpacklo_epi8(d, zero);
+                const __m128i d_hi = _mm_unpackhi_epi8(d, zero);
+                __m128i lo, hi;
+
+                lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(s, zero), d_lo), mm_alpha), 8);
+                hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(s, zero), d_hi), mm_alpha), 8);
+                lo = _mm_add_epi8(lo, d_lo);
+                hi = _mm_add_epi8(hi, d_hi);
+                _mm_storeu_si128((__m128i *) dstp, _mm_or_si128(_mm_packus_epi16(lo, hi), dsta));
+                srcp += 4;
+                dstp += 4;
+            }
+            for (; n > 0; --n) {
+                *dstp = BlendRGBtoRGBSurfaceAlpha(*srcp, *dstp, chanalpha, dalpha);
+                ++srcp;
+                ++dstp;
+            }
+            srcp += srcskip;
+            dstp += dstskip;
+        }
+    }
+}
+
+/* fast ARGB8888->RGB565 blending with pixel alpha */
+static void SDL_TARGETING("sse4.1")
+BlitARGBto565PixelAlphaSSE41(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint16 *dstp = (Uint16 *) info->dst;
+    int dstskip = info->dst_skip >> 1;
+    const __m128i mask565 = _mm_set1_epi32(0x07e0f81f);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 4; n -= 4) {
+            const __m128i s = _mm_loadu_si128((const __m128i *) srcp);
+            __m128i d = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *) dstp));
+
+            ARGB_565_PIXEL_ALPHA_BLEND(_mm, 128, s, d);
+            _mm_storel_epi64((__m128i *) dstp, _mm_packus_epi32(d, d));
+            srcp += 4;
+            dstp += 4;
+        }
+        for (; n > 0; --n) {
+            *dstp = BlendARGBto565PixelAlpha(*srcp, *dstp);
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+#if SDL_AVX2_INTRINSICS
+/* fast ARGB888->(A)RGB888 blending with pixel alpha */
+static void SDL_TARGETING("avx2")
+BlitRGBtoRGBPixelAlphaAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *sf = info->src_fmt;
+    Uint32 amask = sf->Amask;
+    Uint32 ashift = sf->Ashift;
+    const int apos = ashift / 8;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i mm_amask = _mm256_set1_epi32(amask);
+    const __m256i channel_mask = _mm256_set1_epi16(0xFF);
+    const __m256i src_mult = _mm256_broadcastsi128_si256(AlphaChannelMultiplier(ashift));
+    /* AVX2 shuffles and unpacks within each 128-bit half */
+    const __m256i alpha_lo = _mm256_broadcastsi128_si256(ALPHA_TO_CHANNELS_MASK(apos, 0));
+    const __m256i alpha_hi = _mm256_broadcastsi128_si256(ALPHA_TO_CHANNELS_MASK(apos, 2));
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const __m256i s = _mm256_loadu_si256((const __m256i *) srcp);
+            const __m256i d = _mm256_loadu_si256((const __m256i *) dstp);
+            const __m256i alpha = _mm256_and_si256(s, mm_amask);
+            __m256i lo, hi, result;
+
+            lo = PIXEL_ALPHA_BLEND_16(_mm256, 256, _mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero), _mm256_shuffle_epi8(s, alpha_lo));
+            hi = PIXEL_ALPHA_BLEND_16(_mm256, 256, _mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero), _mm256_shuffle_epi8(s, alpha_hi));
+            result = _mm256_packus_epi16(lo, hi);
+            result = _mm256_blendv_epi8(result, s, _mm256_cmpeq_epi32(alpha, mm_amask));
+            result = _mm256_blendv_epi8(result, d, _mm256_cmpeq_epi32(alpha, zero));
+            _mm256_storeu_si256((__m256i *) dstp, result);
+            srcp += 8;
+            dstp += 8;
+        }
+        for (; n > 0; --n) {
+            *dstp = BlendRGBtoRGBPixelAlpha(*srcp, *dstp, amask, ashift);
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* fast ARGB8888->RGB565 blending with pixel alpha */
+static void SDL_TARGETING("avx2")
+BlitARGBto565PixelAlphaAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint16 *dstp = (Uint16 *) info->dst;
+    int dstskip = info->dst_skip >> 1;
+    const __m256i mask565 = _mm256_set1_epi32(0x07e0f81f);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const __m256i s = _mm256_loadu_si256((const __m256i *) srcp);
+            __m256i d = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *) dstp));
+
+            ARGB_565_PIXEL_ALPHA_BLEND(_mm256, 256, s, d);
+            d = _mm256_permute4x64_epi64(_mm256_packus_epi32(d, d), 0x08);
+            _mm_storeu_si128((__m128i *) dstp, _mm256_castsi256_si128(d));
+            srcp += 8;
+            dstp += 8;
+        }
+        for (; n > 0; --n) {
+            *dstp = BlendARGBto565PixelAlpha(*srcp, *dstp);
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+/* ARGB8888->(A)RGB8888 blending with pre-multiplied pixel alpha */
+static void SDL_TARGETING("sse4.1")
+BlitRGBtoRGBPremultipliedPixelAlphaSSE41(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *df = info->dst_fmt;
+    Uint32 ashift = info->src_fmt->Ashift;
+    Uint32 dmask = df->Rmask | df->Gmask | df->Bmask | df->Amask;
+    const int apos = ashift / 8;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one16 = _mm_set1_epi16(1);
+    const __m128i channel_mask = _mm_set1_epi16(0xFF);
+    const __m128i mm_dmask = _mm_set1_epi32(dmask);
+    const __m128i alpha_lo = ALPHA_TO_CHANNELS_MASK(apos, 0);
+    const __m128i alpha_hi = ALPHA_TO_CHANNELS_MASK(apos, 2);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 4; n -= 4) {
+            const __m128i s = _mm_loadu_si128((const __m128i *) srcp);
+            const __m128i d = _mm_loadu_si128((const __m128i *) dstp);
+            __m128i lo, hi;
+
+            lo = PREMULTIPLIED_ALPHA_BLEND_16(_mm, 128, _mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), _mm_shuffle_epi8(s, alpha_lo));
+            hi = PREMULTIPLIED_ALPHA_BLEND_16(_mm, 128, _mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), _mm_shuffle_epi8(s, alpha_hi));
+            _mm_storeu_si128((__m128i *) dstp, _mm_and_si128(_mm_packus_epi16(lo, hi), mm_dmask));
+            srcp += 4;
+            dstp += 4;
+        }
+        for (; n > 0; --n) {
+            *dstp = BlendPremultipliedPixelAlpha(*srcp, *dstp, ashift) & dmask;
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+#if SDL_AVX2_INTRINSICS
+/* ARGB8888->(A)RGB8888 blending with pre-multiplied pixel alpha */
+static void SDL_TARGETING("avx2")
+BlitRGBtoRGBPremultipliedPixelAlphaAVX2(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *df = info->dst_fmt;
+    Uint32 ashift = info->src_fmt->Ashift;
+    Uint32 dmask = df->Rmask | df->Gmask | df->Bmask | df->Amask;
+    const int apos = ashift / 8;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one16 = _mm256_set1_epi16(1);
+    const __m256i channel_mask = _mm256_set1_epi16(0xFF);
+    const __m256i mm_dmask = _mm256_set1_epi32(dmask);
+    const __m256i alpha_lo = _mm256_broadcastsi128_si256(ALPHA_TO_CHANNELS_MASK(apos, 0));
+    const __m256i alpha_hi = _mm256_broadcastsi128_si256(ALPHA_TO_CHANNELS_MASK(apos, 2));
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const __m256i s = _mm256_loadu_si256((const __m256i *) srcp);
+            const __m256i d = _mm256_loadu_si256((const __m256i *) dstp);
+            __m256i lo, hi;
+
+            lo = PREMULTIPLIED_ALPHA_BLEND_16(_mm256, 256, _mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero), _mm256_shuffle_epi8(s, alpha_lo));
+            hi = PREMULTIPLIED_ALPHA_BLEND_16(_mm256, 256, _mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero), _mm256_shuffle_epi8(s, alpha_hi));
+            _mm256_storeu_si256((__m256i *) dstp, _mm256_and_si256(_mm256_packus_epi16(lo, hi), mm_dmask));
+            srcp += 8;
+            dstp += 8;
+        }
+        for (; n > 0; --n) {
+            *dstp = BlendPremultipliedPixelAlpha(*srcp, *dstp, ashift) & dmask;
+            ++srcp;
+            ++dstp;
+        }
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
+#undef PIXEL_ALPHA_BLEND_16
+#undef PREMULTIPLIED_ALPHA_BLEND_16
+#undef ARGB_565_PIXEL_ALPHA_BLEND
+#undef ALPHA_TO_CHANNELS_MASK
+
+/* 32-bit format with 8-bit channels, which the SIMD blitters can shuffle */
+static SDL_bool
+IsByteAligned8888(const SDL_PixelFormat * fmt)
+{
+    return (fmt->BytesPerPixel == 4 &&
+            fmt->Rloss == 0 && fmt->Gloss == 0 && fmt->Bloss == 0 &&
+            fmt->Rshift % 8 == 0 && fmt->Gshift % 8 == 0 && fmt->Bshift % 8 == 0 &&
+            (fmt->Amask == 0 || (fmt->Aloss == 0 && fmt->Ashift % 8 == 0)));
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
 /* fast RGB888->(A)RGB888 blending with surface alpha=128 special case */
 static void
 BlitRGBtoRGBSurfaceAlpha128(SDL_BlitInfo * info)
@@ -1330,6 +1907,73 @@ BlitNtoNPixelAlpha(SDL_BlitInfo * info)
     }
 }
 
+/* ARGB8888->(A)RGB8888 blending with pre-multiplied pixel alpha */
+static void
+BlitRGBtoRGBPremultipliedPixelAlpha(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint32 *srcp = (Uint32 *) info->src;
+    int srcskip = info->src_skip >> 2;
+    Uint32 *dstp = (Uint32 *) info->dst;
+    int dstskip = info->dst_skip >> 2;
+    SDL_PixelFormat *df = info->dst_fmt;
+    Uint32 ashift = info->src_fmt->Ashift;
+    Uint32 dmask = df->Rmask | df->Gmask | df->Bmask | df->Amask;
+
+    while (height--) {
+        /* *INDENT-OFF* */
+        DUFFS_LOOP4({
+        *dstp = BlendPremultipliedPixelAlpha(*srcp, *dstp, ashift) & dmask;
+        ++srcp;
+        ++dstp;
+        }, width);
+        /* *INDENT-ON* */
+        srcp += srcskip;
+        dstp += dstskip;
+    }
+}
+
+/* General (slow) N->N blending with pre-multiplied pixel alpha */
+static void
+BlitNtoNPremultipliedPixelAlpha(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    SDL_PixelFormat *srcfmt = info->src_fmt;
+    SDL_PixelFormat *dstfmt = info->dst_fmt;
+    int srcbpp;
+    int dstbpp;
+    Uint32 Pixel;
+    unsigned sR, sG, sB, sA;
+    unsigned dR, dG, dB, dA;
+
+    /* Set up some basic variables */
+    srcbpp = srcfmt->BytesPerPixel;
+    dstbpp = dstfmt->BytesPerPixel;
+
+    while (height--) {
+        /* *INDENT-OFF* */
+        DUFFS_LOOP4(
+        {
+        DISEMBLE_RGBA(src, srcbpp, srcfmt, Pixel, sR, sG, sB, sA);
+        DISEMBLE_RGBA(dst, dstbpp, dstfmt, Pixel, dR, dG, dB, dA);
+        PREMULTIPLIED_ALPHA_BLEND_RGBA(sR, sG, sB, sA, dR, dG, dB, dA);
+        ASSEMBLE_RGBA(dst, dstbpp, dstfmt, dR, dG, dB, dA);
+        src += srcbpp;
+        dst += dstbpp;
+        },
+        width);
+        /* *INDENT-ON* */
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
 
 SDL_BlitFunc
 SDL_CalculateBlitA(SDL_Surface * surface)
@@ -1370,9 +2014,17 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                     && sf->Gmask == 0xff00
                     && ((sf->Rmask == 0xff && df->Rmask == 0x1f)
                         || (sf->Bmask == 0xff && df->Bmask == 0x1f))) {
-                if (df->Gmask == 0x7e0)
+                if (df->Gmask == 0x7e0) {
+#if SDL_AVX2_INTRINSICS
+                    if (SDL_HasAVX2())
+                        return BlitARGBto565PixelAlphaAVX2;
+#endif
+#if SDL_SSE4_1_INTRINSICS
+                    if (SDL_HasSSE41())
+                        return BlitARGBto565PixelAlphaSSE41;
+#endif
                     return BlitARGBto565PixelAlpha;
-                else if (df->Gmask == 0x3e0)
+                } else if (df->Gmask == 0x3e0)
                     return BlitARGBto555PixelAlpha;
             }
             return BlitNtoNPixelAlpha;
@@ -1381,6 +2033,19 @@ SDL_CalculateBlitA(SDL_Surface * surface)
             if (sf->Rmask == df->Rmask
                 && sf->Gmask == df->Gmask
                 && sf->Bmask == df->Bmask && sf->BytesPerPixel == 4) {
+#if SDL_SSE4_1_INTRINSICS
+                if (sf->Rshift % 8 == 0
+                    && sf->Gshift % 8 == 0
+                    && sf->Bshift % 8 == 0
+                    && sf->Ashift % 8 == 0 && sf->Aloss == 0) {
+#if SDL_AVX2_INTRINSICS
+                    if (SDL_HasAVX2())
+                        return BlitRGBtoRGBPixelAlphaAVX2;
+#endif
+                    if (SDL_HasSSE41())
+                        return BlitRGBtoRGBPixelAlphaSSE41;
+                }
+#endif /* SDL_SSE4_1_INTRINSICS */
 #if defined(__MMX__) || defined(__3dNOW__)
                 if (sf->Rshift % 8 == 0
                     && sf->Gshift % 8 == 0
@@ -1408,6 +2073,11 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                     return BlitRGBtoRGBPixelAlpha;
                 }
             }
+#if SDL_SSE4_1_INTRINSICS
+            if (sf->Amask && IsByteAligned8888(sf) && IsByteAligned8888(df) && SDL_HasSSE41()) {
+                return BlitNtoNPixelAlphaSSE41;
+            }
+#endif
             return BlitNtoNPixelAlpha;
 
         case 3:
@@ -1452,6 +2122,12 @@ SDL_CalculateBlitA(SDL_Surface * surface)
                 if (sf->Rmask == df->Rmask
                     && sf->Gmask == df->Gmask
                     && sf->Bmask == df->Bmask && sf->BytesPerPixel == 4) {
+#if SDL_SSE4_1_INTRINSICS
+                    if (sf->Rshift % 8 == 0
+                        && sf->Gshift % 8 == 0
+                        && sf->Bshift % 8 == 0 && SDL_HasSSE41())
+                        return BlitRGBtoRGBSurfaceAlphaSSE41;
+#endif
 #ifdef __MMX__
                     if (sf->Rshift % 8 == 0
                         && sf->Gshift % 8 == 0
@@ -1486,6 +2162,33 @@ SDL_CalculateBlitA(SDL_Surface * surface)
             }
         }
         break;
+
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        /* Per-pixel pre-multiplied alpha blits, without alpha this is
+           just a copy and is left to the other blitters */
+        if (sf->Amask == 0 || df->palette != NULL) {
+            break;
+        }
+        if (sf->BytesPerPixel == 4 && df->BytesPerPixel == 4
+            && sf->Rmask == df->Rmask
+            && sf->Gmask == df->Gmask
+            && sf->Bmask == df->Bmask
+            && (df->Amask == 0 || df->Amask == sf->Amask)
+            && sf->Rloss == 0 && sf->Rshift % 8 == 0
+            && sf->Gloss == 0 && sf->Gshift % 8 == 0
+            && sf->Bloss == 0 && sf->Bshift % 8 == 0
+            && sf->Aloss == 0 && sf->Ashift % 8 == 0) {
+#if SDL_AVX2_INTRINSICS
+            if (SDL_HasAVX2())
+                return BlitRGBtoRGBPremultipliedPixelAlphaAVX2;
+#endif
+#if SDL_SSE4_1_INTRINSICS
+            if (SDL_HasSSE41())
+                return BlitRGBtoRGBPremultipliedPixelAlphaSSE41;
+#endif
+            return BlitRGBtoRGBPremultipliedPixelAlpha;
+        }
+        return BlitNtoNPremultipliedPixelAlpha;
     }
 
     return NULL;
@@ -97,6 +97,12 @@ SDL_Blit_Slow(SDL_BlitInfo * info)
                 srcB = (srcB * modulateB) / 255;
             }
             if (flags & SDL_COPY_MODULATE_ALPHA) {
+                if (flags & SDL_COPY_BLEND_PREMULTIPLIED) {
+                    /* Pre-multiplied color has to be scaled along with the alpha */
+                    srcR = (srcR * modulateA) / 255;
+                    srcG = (srcG * modulateA) / 255;
+                    srcB = (srcB * modulateA) / 255;
+                }
                 srcA = (srcA * modulateA) / 255;
             }
             if (flags & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
@@ -107,7 +113,7 @@ SDL_Blit_Slow(SDL_BlitInfo * info)
                     srcB = (srcB * srcA) / 255;
                 }
             }
-            switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
+            switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_BLEND_PREMULTIPLIED)) {
             case 0:
                 dstR = srcR;
                 dstG = srcG;
@@ -120,6 +126,18 @@ SDL_Blit_Slow(SDL_BlitInfo * info)
                 dstB = srcB + ((255 - srcA) * dstB) / 255;
                 dstA = srcA + ((255 - srcA) * dstA) / 255;
                 break;
+            case SDL_COPY_BLEND_PREMULTIPLIED:
+                dstR = srcR + ((255 - srcA) * dstR) / 255;
+                if (dstR > 255)
+                    dstR = 255;
+                dstG = srcG + ((255 - srcA) * dstG) / 255;
+                if (dstG > 255)
+                    dstG = 255;
+                dstB = srcB + ((255 - srcA) * dstB) / 255;
+                if (dstB > 255)
+                    dstB = 255;
+                dstA = srcA + ((255 - srcA) * dstA) / 255;
+                break;
             case SDL_COPY_ADD:
                 dstR = srcR + dstR;
                 if (dstR > 255)
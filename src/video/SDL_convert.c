@@ -0,0 +1,467 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* This file converts pixels between the most common RGB formats straight
+   from SDL_ConvertPixels(), without building surfaces and a blit map first.
+
+   Every 8 bits per channel format is described by the byte offset of each
+   of its channels, so converting between two of them is a byte shuffle,
+   which SSE4.1 does 4 pixels at a time. RGB565 is packed and unpacked the
+   same way the blitters do it, so the results match SDL_LowerBlit().
+*/
+
+#include "SDL_cpuinfo.h"
+#include "SDL_endian.h"
+#include "SDL_pixels.h"
+#include "SDL_blit.h"
+#include "SDL_convert_c.h"
+#include "SDL_parallel_c.h"
+
+/* Don't bother with threads for less than this many pixels */
+#define PARALLEL_CONVERT_MIN_PIXELS (512*512)
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define PIXEL_BYTE(shift)   ((shift) / 8)
+#else
+#define PIXEL_BYTE(shift)   (3 - (shift) / 8)
+#endif
+
+typedef struct
+{
+    Uint32 format;
+    int bpp;
+    Sint8 r, g, b, a;   /* byte offset of each channel, -1 if there's none */
+} SDL_ByteLayout;
+
+static const SDL_ByteLayout SDL_byte_layouts[] = {
+    { SDL_PIXELFORMAT_ARGB8888, 4, PIXEL_BYTE(16), PIXEL_BYTE(8), PIXEL_BYTE(0), PIXEL_BYTE(24) },
+    { SDL_PIXELFORMAT_ABGR8888, 4, PIXEL_BYTE(0), PIXEL_BYTE(8), PIXEL_BYTE(16), PIXEL_BYTE(24) },
+    { SDL_PIXELFORMAT_RGBA8888, 4, PIXEL_BYTE(24), PIXEL_BYTE(16), PIXEL_BYTE(8), PIXEL_BYTE(0) },
+    { SDL_PIXELFORMAT_BGRA8888, 4, PIXEL_BYTE(8), PIXEL_BYTE(16), PIXEL_BYTE(24), PIXEL_BYTE(0) },
+    { SDL_PIXELFORMAT_RGB888, 4, PIXEL_BYTE(16), PIXEL_BYTE(8), PIXEL_BYTE(0), -1 },
+    { SDL_PIXELFORMAT_RGB24, 3, 0, 1, 2, -1 }
+};
+
+typedef struct
+{
+    int width;
+    const Uint8 *src;
+    int src_pitch;
+    int src_bpp;
+    Uint8 *dst;
+    int dst_pitch;
+    int dst_bpp;
+    /* For each destination byte, the source byte it comes from, or -1 */
+    Sint8 map[4];
+    /* For each destination byte that doesn't come from the source, its value */
+    Uint8 fill[4];
+    void (*row)(const Uint8 *src, Uint8 *dst, int width, const void *data);
+} SDL_ConvertInfo;
+
+static const SDL_ByteLayout *
+SDL_GetByteLayout(Uint32 format)
+{
+    int i;
+
+    for (i = 0; i < SDL_arraysize(SDL_byte_layouts); ++i) {
+        if (SDL_byte_layouts[i].format == format) {
+            return &SDL_byte_layouts[i];
+        }
+    }
+    return NULL;
+}
+
+static void
+Convert_Swizzle(const Uint8 *src, Uint8 *dst, int width, const void *data)
+{
+    const SDL_ConvertInfo *info = (const SDL_ConvertInfo *)data;
+    const int src_bpp = info->src_bpp;
+    const int dst_bpp = info->dst_bpp;
+    int i, n;
+
+    for (n = width; n--; ) {
+        Uint8 pixel[4];
+
+        /* Read the whole pixel first, in case src and dst are the same */
+        for (i = 0; i < src_bpp; ++i) {
+            pixel[i] = src[i];
+        }
+        for (i = 0; i < dst_bpp; ++i) {
+            dst[i] = (info->map[i] < 0) ? info->fill[i] : pixel[info->map[i]];
+        }
+        src += src_bpp;
+        dst += dst_bpp;
+    }
+}
+
+#if SDL_SSE4_1_INTRINSICS
+/* The shuffle control and fill for 4 pixels */
+static void SDL_TARGETING("sse4.1")
+GetSwizzleSSE41(const SDL_ConvertInfo *info, __m128i *shuffle, __m128i *fill)
+{
+    Uint8 control[16], constant[16];
+    int i, j;
+
+    SDL_memset(control, 0x80, sizeof(control));
+    SDL_memset(constant, 0, sizeof(constant));
+    for (i = 0; i < 4; ++i) {
+        for (j = 0; j < info->dst_bpp; ++j) {
+            const int pos = i * info->dst_bpp + j;
+            if (info->map[j] < 0) {
+                constant[pos] = info->fill[j];
+            } else {
+                control[pos] = (Uint8)(i * info->src_bpp + info->map[j]);
+            }
+        }
+    }
+    *shuffle = _mm_loadu_si128((const __m128i *)control);
+    *fill = _mm_loadu_si128((const __m128i *)constant);
+}
+
+static void SDL_TARGETING("sse4.1")
+Convert_Swizzle4to4SSE41(const Uint8 *src, Uint8 *dst, int width, const void *data)
+{
+    __m128i shuffle, fill;
+    int n = width;
+
+    GetSwizzleSSE41((const SDL_ConvertInfo *)data, &shuffle, &fill);
+    for (; n >= 4; n -= 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)src);
+        _mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_shuffle_epi8(s, shuffle), fill));
+        src += 16;
+        dst += 16;
+    }
+    Convert_Swizzle(src, dst, n, data);
+}
+
+static void SDL_TARGETING("sse4.1")
+Convert_Swizzle3to4SSE41(const Uint8 *src, Uint8 *dst, int width, const void *data)
+{
+    __m128i shuffle, fill;
+    int n = width;
+
+    GetSwizzleSSE41((const SDL_ConvertInfo *)data, &shuffle, &fill);
+    for (; n >= 4; n -= 4) {
+        /* Only load the 12 bytes of these 4 pixels, the row may end there */
+        __m128i s = _mm_loadl_epi64((const __m128i *)src);
+        s = _mm_insert_epi32(s, *(const int *)(src + 8), 2);
+        _mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_shuffle_epi8(s, shuffle), fill));
+        src += 12;
+        dst += 16;
+    }
+    Convert_Swizzle(src, dst, n, data);
+}
+
+static void SDL_TARGETING("sse4.1")
+Convert_Swizzle4to3SSE41(const Uint8 *src, Uint8 *dst, int width, const void *data)
+{
+    __m128i shuffle, fill;
+    int n = width;
+
+    GetSwizzleSSE41((const SDL_ConvertInfo *)data, &shuffle, &fill);
+    for (; n >= 4; n -= 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)src);
+        const __m128i d = _mm_or_si128(_mm_shuffle_epi8(s, shuffle), fill);
+        _mm_storel_epi64((__m128i *)dst, d);
+        *(int *)(dst + 8) = _mm_extract_epi32(d, 2);
+        src += 16;
+        dst += 12;
+    }
+    Convert_Swizzle(src, dst, n, data);
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define BYTE_SHIFT(offset)  ((offset) * 8)
+#else
+#define BYTE_SHIFT(offset)  ((3 - (offset)) * 8)
+#endif
+
+/* Truncates each channel, like the blitters do */
+static void
+Convert_ToRGB565(const Uint8 *src, Uint8 *dst, int width, const void *data)
+{
+    const SDL_ConvertInfo *info = (const SDL_ConvertInfo *)data;
+    const int r = info->map[0], g = info->map[1], b = info->map[2];
+    Uint16 *dstp = (Uint16 *)dst;
+    int n;
+
+    if (info->src_bpp == 4) {
+        const int rshift = BYTE_SHIFT(r) + 3;
+        const int gshift = BYTE_SHIFT(g) + 2;
+        const int bshift = BYTE_SHIFT(b) + 3;
+
+        for (n = width; n--; ) {
+            const Uint32 pixel = *(const Uint32 *)src;
+            *dstp++ = (Uint16)((((pixel >> rshift) & 0x1F) << 11) |
+                               (((pixel >> gshift) & 0x3F) << 5) |
+                               ((pixel >> bshift) & 0x1F));
+            src += 4;
+        }
+    } else {
+        for (n = width; n--; ) {
+            *dstp++ = (Uint16)(((src[r] >> 3) << 11) | ((src[g] >> 2) << 5) | (src[b] >> 3));
+            src += 3;
+        }
+    }
+}
+
+/* Expands each channel with SDL_expand_byte, like the blitters do. The
+   32-bit ones look pixels up in two halves, one byte at a time, so the
+   green channel they produce is rounded down a bit further, match that. */
+static void
+Convert_FromRGB565(const Uint8 *src, Uint8 *dst, int width, const void *data)
+{
+    const SDL_ConvertInfo *info = (const SDL_ConvertInfo *)data;
+    const int r = info->map[0], g = info->map[1], b = info->map[2];
+    const Uint8 *expand5 = SDL_expand_byte[3];
+    const Uint8 *expand6 = SDL_expand_byte[2];
+    const Uint16 *srcp = (const Uint16 *)src;
+    int n;
+
+    if (info->dst_bpp == 4) {
+        const int rshift = BYTE_SHIFT(r);
+        const int gshift = BYTE_SHIFT(g);
+        const int bshift = BYTE_SHIFT(b);
+        Uint32 *dstp = (Uint32 *)dst;
+        Uint32 fill = *(const Uint32 *)info->fill;
+
+        fill &= ~((0xFFu << rshift) | (0xFFu << gshift) | (0xFFu << bshift));
+        for (n = width; n--; ) {
+            const Uint16 pixel = *srcp++;
+            *dstp++ = fill |
+                     ((Uint32)expand5[pixel >> 11] << rshift) |
+                     ((Uint32)(expand6[(pixel >> 5) & 0x38] + ((pixel >> 3) & 0x1C)) << gshift) |
+                     ((Uint32)expand5[pixel & 0x1F] << bshift);
+        }
+    } else {
+        for (n = width; n--; ) {
+            const Uint16 pixel = *srcp++;
+            dst[r] = expand5[pixel >> 11];
+            dst[g] = expand6[(pixel >> 5) & 0x3F];
+            dst[b] = expand5[pixel & 0x1F];
+            dst += 3;
+        }
+    }
+}
+
+#if SDL_SSE4_1_INTRINSICS
+/* The shuffle control between 4 pixels stored as bytes r, g, b, x and
+   the pixel layout of the other side */
+static __m128i SDL_TARGETING("sse4.1")
+GetRGBXShuffleSSE41(const SDL_ConvertInfo *info, int bpp, SDL_bool to_rgbx)
+{
+    Uint8 control[16];
+    int i, j;
+
+    SDL_memset(control, 0x80, sizeof(control));
+    for (i = 0; i < 4; ++i) {
+        if (!to_rgbx) {
+            for (j = 0; j < bpp; ++j) {
+                control[i * bpp + j] = (Uint8)(i * 4 + 3);
+            }
+        }
+        for (j = 0; j < 3; ++j) {
+            if (to_rgbx) {
+                control[i * 4 + j] = (Uint8)(i * bpp + info->map[j]);
+            } else {
+                control[i * bpp + info->map[j]] = (Uint8)(i * 4 + j);
+            }
+        }
+    }
+    return _mm_loadu_si128((const __m128i *)control);
+}
+
+static SDL_INLINE __m128i SDL_TARGETING("sse4.1")
+LoadRGBXSSE41(const Uint8 *src, int bpp, __m128i shuffle)
+{
+    __m128i s;
+
+    if (bpp == 4) {
+        s = _mm_loadu_si128((const __m128i *)src);
+    } else {
+        s = _mm_loadl_epi64((const __m128i *)src);
+        s = _mm_insert_epi32(s, *(const int *)(src + 8), 2);
+    }
+    return _mm_shuffle_epi8(s, shuffle);
+}
+
+static void SDL_TARGETING("sse4.1")
+Convert_ToRGB565SSE41(const Uint8 *src, Uint8 *dst, int width, const void *data)
+{
+    const SDL_ConvertInfo *info = (const SDL_ConvertInfo *)data;
+    const int bpp = info->src_bpp;
+    const __m128i shuffle = GetRGBXShuffleSSE41(info, bpp, SDL_TRUE);
+    const __m128i rmask = _mm_set1_epi32(0xF8);
+    const __m128i gmask = _mm_set1_epi32(0x07E0);
+    const __m128i bmask = _mm_set1_epi32(0x1F);
+    int n = width;
+
+    for (; n >= 8; n -= 8) {
+        __m128i p[2];
+        int i;
+
+        for (i = 0; i < 2; ++i) {
+            const __m128i s = LoadRGBXSSE41(src + i * 4 * bpp, bpp, shuffle);
+            p[i] = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(s, rmask), 8),
+                   _mm_or_si128(_mm_and_si128(_mm_srli_epi32(s, 5), gmask),
+                                _mm_and_si128(_mm_srli_epi32(s, 19), bmask)));
+        }
+        _mm_storeu_si128((__m128i *)dst, _mm_packus_epi32(p[0], p[1]));
+        src += 8 * bpp;
+        dst += 16;
+    }
+    Convert_ToRGB565(src, dst, n, data);
+}
+
+/* Same arithmetic as Convert_FromRGB565(), v * 255 / 31 is (v * 2106) >> 8
+   and the top half of green times 255 / 63 is (v * 1035) >> 8 */
+static void SDL_TARGETING("sse4.1")
+Convert_FromRGB565SSE41(const Uint8 *src, Uint8 *dst, int width, const void *data)
+{
+    const SDL_ConvertInfo *info = (const SDL_ConvertInfo *)data;
+    const __m128i shuffle = GetRGBXShuffleSSE41(info, 4, SDL_FALSE);
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+    const __m128i ghi_mask = _mm_set1_epi16(0x38);
+    const __m128i glo_mask = _mm_set1_epi16(0x07);
+    const __m128i expand5 = _mm_set1_epi16(2106);
+    const __m128i expand_ghi = _mm_set1_epi16(1035);
+    const __m128i opaque = _mm_set1_epi16((short)0xFF00);
+    int n = width;
+
+    for (; n >= 8; n -= 8) {
+        const __m128i p = _mm_loadu_si128((const __m128i *)src);
+        const __m128i g6 = _mm_and_si128(_mm_srli_epi16(p, 5), mask6);
+        const __m128i r = _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi16(p, 11), expand5), 8);
+        const __m128i g = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(g6, ghi_mask), expand_ghi), 8),
+                                        _mm_slli_epi16(_mm_and_si128(g6, glo_mask), 2));
+        const __m128i b = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(p, mask5), expand5), 8);
+        const __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+        const __m128i bx = _mm_or_si128(b, opaque);
+        _mm_storeu_si128((__m128i *)dst, _mm_shuffle_epi8(_mm_unpacklo_epi16(rg, bx), shuffle));
+        _mm_storeu_si128((__m128i *)(dst + 16), _mm_shuffle_epi8(_mm_unpackhi_epi16(rg, bx), shuffle));
+        src += 16;
+        dst += 32;
+    }
+    Convert_FromRGB565(src, dst, n, data);
+}
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+static void
+SDL_ConvertRows(void *data, int row_begin, int row_end)
+{
+    const SDL_ConvertInfo *info = (const SDL_ConvertInfo *)data;
+    const Uint8 *src = info->src + row_begin * info->src_pitch;
+    Uint8 *dst = info->dst + row_begin * info->dst_pitch;
+    int row;
+
+    for (row = row_begin; row < row_end; ++row) {
+        info->row(src, dst, info->width, info);
+        src += info->src_pitch;
+        dst += info->dst_pitch;
+    }
+}
+
+SDL_bool
+SDL_ConvertPixels_Direct(int width, int height,
+                         Uint32 src_format, const void *src, int src_pitch,
+                         Uint32 dst_format, void *dst, int dst_pitch)
+{
+    const SDL_ByteLayout *src_layout = SDL_GetByteLayout(src_format);
+    const SDL_ByteLayout *dst_layout = SDL_GetByteLayout(dst_format);
+    SDL_ConvertInfo info;
+    int i;
+
+    if (width <= 0 || height <= 0) {
+        return SDL_FALSE;
+    }
+
+    SDL_zero(info);
+    info.width = width;
+    info.src = (const Uint8 *)src;
+    info.src_pitch = src_pitch;
+    info.dst = (Uint8 *)dst;
+    info.dst_pitch = dst_pitch;
+
+    if (src_layout && dst_layout) {
+        info.src_bpp = src_layout->bpp;
+        info.dst_bpp = dst_layout->bpp;
+        for (i = 0; i < dst_layout->bpp; ++i) {
+            /* Missing alpha is opaque, padding bytes are cleared */
+            info.map[i] = -1;
+            info.fill[i] = (i == dst_layout->a) ? 0xFF : 0x00;
+        }
+        info.map[(int)dst_layout->r] = src_layout->r;
+        info.map[(int)dst_layout->g] = src_layout->g;
+        info.map[(int)dst_layout->b] = src_layout->b;
+        if (dst_layout->a >= 0) {
+            info.map[(int)dst_layout->a] = src_layout->a;
+        }
+
+        info.row = Convert_Swizzle;
+#if SDL_SSE4_1_INTRINSICS
+        if (SDL_HasSSE41()) {
+            if (info.src_bpp == 4 && info.dst_bpp == 4) {
+                info.row = Convert_Swizzle4to4SSE41;
+            } else if (info.src_bpp == 3 && info.dst_bpp == 4) {
+                info.row = Convert_Swizzle3to4SSE41;
+            } else if (info.src_bpp == 4 && info.dst_bpp == 3) {
+                info.row = Convert_Swizzle4to3SSE41;
+            }
+        }
+#endif
+    } else if (src_layout && dst_format == SDL_PIXELFORMAT_RGB565) {
+        info.src_bpp = src_layout->bpp;
+        info.dst_bpp = 2;
+        info.map[0] = src_layout->r;
+        info.map[1] = src_layout->g;
+        info.map[2] = src_layout->b;
+        info.row = Convert_ToRGB565;
+#if SDL_SSE4_1_INTRINSICS
+        if (SDL_HasSSE41()) {
+            info.row = Convert_ToRGB565SSE41;
+        }
+#endif
+    } else if (src_format == SDL_PIXELFORMAT_RGB565 && dst_layout) {
+        info.src_bpp = 2;
+        info.dst_bpp = dst_layout->bpp;
+        info.map[0] = dst_layout->r;
+        info.map[1] = dst_layout->g;
+        info.map[2] = dst_layout->b;
+        /* RGB565 is opaque, and the blitters have always set padding too */
+        SDL_memset(info.fill, 0xFF, sizeof(info.fill));
+        info.row = Convert_FromRGB565;
+#if SDL_SSE4_1_INTRINSICS
+        if (SDL_HasSSE41() && info.dst_bpp == 4) {
+            info.row = Convert_FromRGB565SSE41;
+        }
+#endif
+    } else {
+        return SDL_FALSE;
+    }
+
+    SDL_ParallelRows(height, 1, PARALLEL_CONVERT_MIN_PIXELS / 2 / width + 1, SDL_ConvertRows, &info);
+    return SDL_TRUE;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,35 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_convert_c_h_
+#define SDL_convert_c_h_
+
+#include "../SDL_internal.h"
+
+
+/* Converts between the common RGB formats without setting up a blit.
+   Returns SDL_FALSE, without touching dst, if there is no direct
+   converter for this pair of formats. */
+extern SDL_bool SDL_ConvertPixels_Direct(int width, int height, Uint32 src_format, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch);
+
+#endif /* SDL_convert_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
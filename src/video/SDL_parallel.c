@@ -0,0 +1,109 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_cpuinfo.h"
+#include "SDL_hints.h"
+#include "SDL_parallel_c.h"
+#include "../thread/SDL_systhread.h"
+
+#define MAX_ROW_BANDS   32
+
+typedef struct
+{
+    SDL_RowBandFunc func;
+    void *data;
+    int row_begin;
+    int row_end;
+} SDL_RowBand;
+
+static int
+SDL_GetNumRowBandThreads(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_PIXEL_CONVERSION_THREADS);
+    int count = hint ? SDL_atoi(hint) : 1;
+
+    if (count <= 0) {
+        count = SDL_GetCPUCount();
+    }
+    return SDL_min(count, MAX_ROW_BANDS);
+}
+
+#if !SDL_THREADS_DISABLED
+static int SDLCALL
+SDL_RowBandThread(void *data)
+{
+    SDL_RowBand *band = (SDL_RowBand *)data;
+
+    band->func(band->data, band->row_begin, band->row_end);
+    return 0;
+}
+#endif
+
+void
+SDL_ParallelRows(int rows, int row_align, int min_rows, SDL_RowBandFunc func, void *data)
+{
+#if !SDL_THREADS_DISABLED
+    SDL_RowBand bands[MAX_ROW_BANDS];
+    SDL_Thread *threads[MAX_ROW_BANDS];
+    int i, num_bands, band_rows;
+
+    num_bands = SDL_GetNumRowBandThreads();
+    if (min_rows > 0) {
+        num_bands = SDL_min(num_bands, rows / min_rows);
+    }
+    if (num_bands <= 1) {
+        func(data, 0, rows);
+        return;
+    }
+
+    band_rows = (rows + num_bands - 1) / num_bands;
+    band_rows = ((band_rows + row_align - 1) / row_align) * row_align;
+
+    for (i = 0; i < num_bands; ++i) {
+        bands[i].func = func;
+        bands[i].data = data;
+        bands[i].row_begin = SDL_min(i * band_rows, rows);
+        bands[i].row_end = SDL_min(bands[i].row_begin + band_rows, rows);
+    }
+
+    /* The calling thread takes the first band itself */
+    for (i = 1; i < num_bands; ++i) {
+        threads[i] = NULL;
+        if (bands[i].row_begin < bands[i].row_end) {
+            threads[i] = SDL_CreateThreadInternal(SDL_RowBandThread, "SDLRowBand", 0, &bands[i]);
+            if (!threads[i]) {
+                SDL_RowBandThread(&bands[i]);
+            }
+        }
+    }
+    SDL_RowBandThread(&bands[0]);
+    for (i = 1; i < num_bands; ++i) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+    }
+#else
+    func(data, 0, rows);
+#endif /* !SDL_THREADS_DISABLED */
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
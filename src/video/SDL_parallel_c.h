@@ -0,0 +1,40 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#ifndef SDL_parallel_c_h_
+#define SDL_parallel_c_h_
+
+/* Processes the rows [row_begin, row_end) of an image */
+typedef void (*SDL_RowBandFunc)(void *data, int row_begin, int row_end);
+
+/* Splits an image into bands of rows and runs func on them in parallel.
+
+   The number of threads comes from SDL_HINT_PIXEL_CONVERSION_THREADS, every
+   band except the last starts and ends on a multiple of row_align, and no
+   band is smaller than min_rows. The bands are disjoint, so func must only
+   touch the rows it is given. Returns once all the bands are done.
+ */
+extern void SDL_ParallelRows(int rows, int row_align, int min_rows, SDL_RowBandFunc func, void *data);
+
+#endif /* SDL_parallel_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
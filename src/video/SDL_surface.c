@@ -26,6 +26,7 @@
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 #include "SDL_yuv_c.h"
+#include "SDL_convert_c.h"
 #include "../render/SDL_sysrender.h"
 
 
@@ -511,7 +512,7 @@ SDL_SetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode blendMode)
     status = 0;
     flags = surface->map->info.flags;
     surface->map->info.flags &=
-        ~(SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL);
+        ~(SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_BLEND_PREMULTIPLIED);
     switch (blendMode) {
     case SDL_BLENDMODE_NONE:
         break;
@@ -527,6 +528,9 @@ SDL_SetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode blendMode)
     case SDL_BLENDMODE_MUL:
         surface->map->info.flags |= SDL_COPY_MUL;
         break;
+    case SDL_BLENDMODE_BLEND_PREMULTIPLIED:
+        surface->map->info.flags |= SDL_COPY_BLEND_PREMULTIPLIED;
+        break;
     default:
         status = SDL_Unsupported();
         break;
@@ -551,7 +555,7 @@ SDL_GetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode *blendMode)
     }
 
     switch (surface->map->
-            info.flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
+            info.flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_BLEND_PREMULTIPLIED)) {
     case SDL_COPY_BLEND:
         *blendMode = SDL_BLENDMODE_BLEND;
         break;
@@ -564,6 +568,9 @@ SDL_GetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode *blendMode)
     case SDL_COPY_MUL:
         *blendMode = SDL_BLENDMODE_MUL;
         break;
+    case SDL_COPY_BLEND_PREMULTIPLIED:
+        *blendMode = SDL_BLENDMODE_BLEND_PREMULTIPLIED;
+        break;
     default:
         *blendMode = SDL_BLENDMODE_NONE;
         break;
@@ -921,7 +928,7 @@ SDL_PrivateLowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
     static const Uint32 complex_copy_flags = (
         SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA |
         SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL |
-        SDL_COPY_COLORKEY
+        SDL_COPY_BLEND_PREMULTIPLIED | SDL_COPY_COLORKEY
     );
 
     if (srcrect->w > SDL_MAX_UINT16 || srcrect->h > SDL_MAX_UINT16 ||
@@ -1214,7 +1221,7 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
     convert->map->info.a = copy_color.a;
     convert->map->info.flags =
         (copy_flags &
-         ~(SDL_COPY_COLORKEY | SDL_COPY_BLEND
+         ~(SDL_COPY_COLORKEY | SDL_COPY_BLEND | SDL_COPY_BLEND_PREMULTIPLIED
            | SDL_COPY_RLE_DESIRED | SDL_COPY_RLE_COLORKEY |
            SDL_COPY_RLE_ALPHAKEY));
     surface->map->info.r = copy_color.r;
@@ -1298,7 +1305,10 @@ SDL_ConvertSurface(SDL_Surface * surface, const SDL_PixelFormat * format,
 
     /* Enable alpha blending by default if the new surface has an
      * alpha channel or alpha modulation */
-    if ((surface->format->Amask && format->Amask) ||
+    if (copy_flags & SDL_COPY_BLEND_PREMULTIPLIED) {
+        /* The pixels are still pre-multiplied, keep blending them that way */
+        SDL_SetSurfaceBlendMode(convert, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+    } else if ((surface->format->Amask && format->Amask) ||
         (palette_has_alpha && format->Amask) ||
         (copy_flags & SDL_COPY_MODULATE_ALPHA)) {
         SDL_SetSurfaceBlendMode(convert, SDL_BLENDMODE_BLEND);
@@ -1415,6 +1425,12 @@ int SDL_ConvertPixels(int width, int height,
         return 0;
     }
 
+    /* Common RGB formats don't need the blit machinery */
+    if (SDL_ConvertPixels_Direct(width, height, src_format, src, src_pitch,
+                                 dst_format, dst, dst_pitch)) {
+        return 0;
+    }
+
     if (!SDL_CreateSurfaceOnStack(width, height, src_format, nonconst_src,
                                   src_pitch,
                                   &src_surface, &src_fmt, &src_blitmap)) {
@@ -1438,6 +1454,96 @@ int SDL_ConvertPixels(int width, int height,
     return ret;
 }
 
+/*
+ * Premultiply the alpha on 8888 pixels in place, rounding down the same way
+ * the blitters do before blending.
+ */
+static void
+SDL_PremultiplyAlpha8888(int width, int height, int ashift, void * pixels, int pitch)
+{
+    const Uint32 amask = 0xFFu << ashift;
+    int i;
+
+    while (height--) {
+        Uint32 *p = (Uint32 *) pixels;
+        for (i = width; i--; ++p) {
+            const Uint32 pixel = *p;
+            const Uint32 alpha = (pixel >> ashift) & 0xFF;
+            Uint32 c1, c2;
+
+            if (alpha == 0xFF) {
+                continue;
+            }
+            c1 = (pixel & 0x00ff00ff) * alpha;
+            c2 = (pixel >> 8 & 0x00ff00ff) * alpha;
+            c1 = ((c1 + 0x00010001 + (c1 >> 8 & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+            c2 = ((c2 + 0x00010001 + (c2 >> 8 & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+            *p = ((c1 | c2 << 8) & ~amask) | (pixel & amask);
+        }
+        pixels = (Uint8 *) pixels + pitch;
+    }
+}
+
+int SDL_PremultiplyAlpha(int width, int height,
+                         Uint32 src_format, const void * src, int src_pitch,
+                         Uint32 dst_format, void * dst, int dst_pitch)
+{
+    void *tmp = NULL;
+    void *pixels = dst;
+    int pitch = dst_pitch;
+    Uint32 format = dst_format;
+    int ashift, ret = 0;
+
+    if (!src) {
+        return SDL_InvalidParamError("src");
+    }
+    if (!src_pitch) {
+        return SDL_InvalidParamError("src_pitch");
+    }
+    if (!dst) {
+        return SDL_InvalidParamError("dst");
+    }
+    if (!dst_pitch) {
+        return SDL_InvalidParamError("dst_pitch");
+    }
+
+    /* Work directly in the destination when it has 8-bit channels and alpha */
+    switch (dst_format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+        ashift = 24;
+        break;
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+        ashift = 0;
+        break;
+    default:
+        pitch = width * 4;
+        tmp = SDL_malloc((size_t)pitch * height);
+        if (!tmp) {
+            return SDL_OutOfMemory();
+        }
+        pixels = tmp;
+        format = SDL_PIXELFORMAT_ARGB8888;
+        ashift = 24;
+        break;
+    }
+
+    if (src != pixels || src_format != format) {
+        ret = SDL_ConvertPixels(width, height, src_format, src, src_pitch, format, pixels, pitch);
+    }
+    if (ret == 0) {
+        SDL_PremultiplyAlpha8888(width, height, ashift, pixels, pitch);
+    }
+    if (tmp) {
+        if (ret == 0) {
+            ret = SDL_ConvertPixels(width, height, format, tmp, pitch, dst_format, dst, dst_pitch);
+        }
+        SDL_free(tmp);
+    }
+    return ret;
+}
+
 /*
  * Free a surface created by the above function.
  */
@@ -24,6 +24,7 @@
 #include "SDL_video.h"
 #include "SDL_pixels_c.h"
 #include "SDL_yuv_c.h"
+#include "SDL_parallel_c.h"
 
 #include "yuv2rgb/yuv_rgb.h"
 
@@ -181,6 +182,115 @@ static int GetYUVPlanes(int width, int height, Uint32 format, const void *yuv, i
     return 0;
 }
 
+static SDL_bool yuv_rgb_avx2(
+    Uint32 src_format, Uint32 dst_format,
+    Uint32 width, Uint32 height, 
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride, 
+    Uint8 *rgb, Uint32 rgb_stride, 
+    YCbCrType yuv_type)
+{
+#if defined(__SSE2__) && SDL_AVX2_INTRINSICS
+    if (!SDL_HasAVX2()) {
+        return SDL_FALSE;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv420_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv420_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGR888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YUY2 ||
+        src_format == SDL_PIXELFORMAT_UYVY ||
+        src_format == SDL_PIXELFORMAT_YVYU) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv422_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv422_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv422_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv422_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv422_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGR888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv422_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuvnv12_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB24:
+            yuvnv12_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_RGB888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        case SDL_PIXELFORMAT_BGR888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return SDL_TRUE;
+        default:
+            break;
+        }
+    }
+#endif
+    return SDL_FALSE;
+}
+
 static SDL_bool yuv_rgb_sse(
     Uint32 src_format, Uint32 dst_format,
     Uint32 width, Uint32 height, 
@@ -413,6 +523,10 @@ SDL_ConvertPixels_YUV_to_RGB(int width, int height,
         return -1;
     }
 
+    if (yuv_rgb_avx2(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8*)dst, dst_pitch, yuv_type)) {
+        return 0;
+    }
+
     if (yuv_rgb_sse(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8*)dst, dst_pitch, yuv_type)) {
         return 0;
     }
@@ -456,6 +570,31 @@ struct RGB2YUVFactors
     float v[3]; /* Rfactor, Gfactor, Bfactor */
 };
 
+static const struct RGB2YUVFactors RGB2YUVFactorTables[SDL_YUV_CONVERSION_BT709 + 1] =
+{
+    /* ITU-T T.871 (JPEG) */
+    {
+        0,
+        {  0.2990f,  0.5870f,  0.1140f },
+        { -0.1687f, -0.3313f,  0.5000f },
+        {  0.5000f, -0.4187f, -0.0813f },
+    },
+    /* ITU-R BT.601-7 */
+    {
+        16,
+        {  0.2568f,  0.5041f,  0.0979f },
+        { -0.1482f, -0.2910f,  0.4392f },
+        {  0.4392f, -0.3678f, -0.0714f },
+    },
+    /* ITU-R BT.709-6 */
+    {
+        16,
+        { 0.1826f,  0.6142f,  0.0620f },
+        {-0.1006f, -0.3386f,  0.4392f },
+        { 0.4392f, -0.3989f, -0.0403f },
+    },
+};
+
 static int
 SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int src_pitch, Uint32 dst_format, void *dst, int dst_pitch)
 {
@@ -466,30 +605,6 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
     const int width_remainder  = (width & 0x1);
     int i, j;
  
-    static struct RGB2YUVFactors RGB2YUVFactorTables[SDL_YUV_CONVERSION_BT709 + 1] =
-    {
-        /* ITU-T T.871 (JPEG) */
-        {
-            0,
-            {  0.2990f,  0.5870f,  0.1140f },
-            { -0.1687f, -0.3313f,  0.5000f },
-            {  0.5000f, -0.4187f, -0.0813f },
-        },
-        /* ITU-R BT.601-7 */
-        {
-            16,
-            {  0.2568f,  0.5041f,  0.0979f },
-            { -0.1482f, -0.2910f,  0.4392f },
-            {  0.4392f, -0.3678f, -0.0714f },
-        },
-        /* ITU-R BT.709-6 */
-        {
-            16,
-            { 0.1826f,  0.6142f,  0.0620f },
-            {-0.1006f, -0.3386f,  0.4392f },
-            { 0.4392f, -0.3989f, -0.0403f },
-        },
-    };
     const struct RGB2YUVFactors *cvt = &RGB2YUVFactorTables[SDL_GetYUVConversionModeForResolution(width, height)];
 
 #define MAKE_Y(r, g, b) (Uint8)((int)(cvt->y[0] * (r) + cvt->y[1] * (g) + cvt->y[2] * (b) + 0.5f) + cvt->y_offset)
@@ -782,6 +897,241 @@ SDL_ConvertPixels_ARGB8888_to_YUV(int width, int height, const void *src, int sr
     return 0;
 }
 
+/* Direct conversion from 24 and 32-bit RGB formats to the 4:2:0 formats,
+   giving the same result as SDL_ConvertPixels_ARGB8888_to_YUV() but without
+   an intermediate ARGB8888 copy of the image. */
+typedef struct
+{
+    const struct RGB2YUVFactors *cvt;
+    int width;
+    int height;
+    int bpp;
+    int r_offset;
+    int g_offset;
+    int b_offset;
+    const Uint8 *src;
+    int src_pitch;
+    Uint8 *plane_y;
+    Uint8 *plane_u;
+    Uint8 *plane_v;
+    Uint32 y_stride;
+    Uint32 uv_stride;
+    int uv_pixel_stride;
+    SDL_bool use_SSE2;
+} RGBtoPlanar2x2Info;
+
+static SDL_bool
+GetRGBByteOffsets(Uint32 format, int *bpp, int *r_offset, int *g_offset, int *b_offset)
+{
+    Uint32 masks[4];
+    int offsets[3];
+    int bits, i, k;
+
+    if (SDL_BYTESPERPIXEL(format) != 3 && SDL_BYTESPERPIXEL(format) != 4) {
+        return SDL_FALSE;
+    }
+    if (!SDL_PixelFormatEnumToMasks(format, &bits, &masks[0], &masks[1], &masks[2], &masks[3])) {
+        return SDL_FALSE;
+    }
+    *bpp = SDL_BYTESPERPIXEL(format);
+
+    for (i = 0; i < 3; ++i) {
+        for (k = 0; k < *bpp; ++k) {
+            if (masks[i] == ((Uint32)0xFF << (k * 8))) {
+                break;
+            }
+        }
+        if (k == *bpp) {
+            return SDL_FALSE;
+        }
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        offsets[i] = k;
+#else
+        offsets[i] = (*bpp - 1) - k;
+#endif
+    }
+    *r_offset = offsets[0];
+    *g_offset = offsets[1];
+    *b_offset = offsets[2];
+    return SDL_TRUE;
+}
+
+#ifdef __SSE2__
+/* Converts 8 pixels of two rows at a time, returns the number of pixels done.
+   The float math is done in the same order as the scalar code, so the
+   results are identical. */
+static int
+RGBtoPlanar2x2_SSE2(const RGBtoPlanar2x2Info *info,
+                    const Uint8 *row0, const Uint8 *row1,
+                    Uint8 *y0, Uint8 *y1, Uint8 *u, Uint8 *v)
+{
+    const struct RGB2YUVFactors *cvt = info->cvt;
+    const __m128i r_shift = _mm_cvtsi32_si128(info->r_offset * 8);
+    const __m128i g_shift = _mm_cvtsi32_si128(info->g_offset * 8);
+    const __m128i b_shift = _mm_cvtsi32_si128(info->b_offset * 8);
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const __m128i byte_mask = _mm_set1_epi16(0xFF);
+    const __m128i y_offset = _mm_set1_epi16((short)cvt->y_offset);
+    const __m128i uv_offset = _mm_set1_epi16(128);
+    const __m128 half = _mm_set1_ps(0.5f);
+    int i;
+
+#define CHANNEL(px, shift) _mm_and_si128(_mm_srl_epi32(px, shift), mask)
+#define DOT(k, r, g, b) \
+    _mm_cvttps_epi32(_mm_add_ps(_mm_add_ps(_mm_add_ps( \
+        _mm_mul_ps(_mm_set1_ps(k[0]), _mm_cvtepi32_ps(r)), \
+        _mm_mul_ps(_mm_set1_ps(k[1]), _mm_cvtepi32_ps(g))), \
+        _mm_mul_ps(_mm_set1_ps(k[2]), _mm_cvtepi32_ps(b))), half))
+/* Matches the (Uint8) truncation of the scalar code */
+#define TO_BYTES(a, b, offset) \
+    _mm_packus_epi16(_mm_and_si128(_mm_add_epi16(_mm_packs_epi32(a, b), offset), byte_mask), _mm_setzero_si128())
+#define MAKE_Y4(px) DOT(cvt->y, CHANNEL(px, r_shift), CHANNEL(px, g_shift), CHANNEL(px, b_shift))
+#define PAIR_SUM(a, b, shuffle) \
+    _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), shuffle))
+#define AVERAGE_2x2(shift, avg) \
+    { \
+        const __m128i sum1 = _mm_add_epi32(CHANNEL(a0, shift), CHANNEL(b0, shift)); \
+        const __m128i sum2 = _mm_add_epi32(CHANNEL(a1, shift), CHANNEL(b1, shift)); \
+        avg = _mm_srli_epi32(_mm_add_epi32(PAIR_SUM(sum1, sum2, _MM_SHUFFLE(2, 0, 2, 0)), \
+                                           PAIR_SUM(sum1, sum2, _MM_SHUFFLE(3, 1, 3, 1))), 2); \
+    }
+
+    for (i = 0; i + 8 <= info->width; i += 8) {
+        const __m128i a0 = _mm_loadu_si128((const __m128i *)(row0 + i * 4));
+        const __m128i a1 = _mm_loadu_si128((const __m128i *)(row0 + i * 4 + 16));
+        const __m128i b0 = _mm_loadu_si128((const __m128i *)(row1 + i * 4));
+        const __m128i b1 = _mm_loadu_si128((const __m128i *)(row1 + i * 4 + 16));
+        __m128i r, g, b, U, V;
+
+        _mm_storel_epi64((__m128i *)(y0 + i), TO_BYTES(MAKE_Y4(a0), MAKE_Y4(a1), y_offset));
+        _mm_storel_epi64((__m128i *)(y1 + i), TO_BYTES(MAKE_Y4(b0), MAKE_Y4(b1), y_offset));
+
+        AVERAGE_2x2(r_shift, r);
+        AVERAGE_2x2(g_shift, g);
+        AVERAGE_2x2(b_shift, b);
+        U = TO_BYTES(DOT(cvt->u, r, g, b), _mm_setzero_si128(), uv_offset);
+        V = TO_BYTES(DOT(cvt->v, r, g, b), _mm_setzero_si128(), uv_offset);
+
+        if (info->uv_pixel_stride == 1) {
+            const int u4 = _mm_cvtsi128_si32(U);
+            const int v4 = _mm_cvtsi128_si32(V);
+            SDL_memcpy(u + i / 2, &u4, sizeof(u4));
+            SDL_memcpy(v + i / 2, &v4, sizeof(v4));
+        } else if (u < v) {
+            _mm_storel_epi64((__m128i *)(u + i), _mm_unpacklo_epi8(U, V));
+        } else {
+            _mm_storel_epi64((__m128i *)(v + i), _mm_unpacklo_epi8(V, U));
+        }
+    }
+#undef CHANNEL
+#undef DOT
+#undef TO_BYTES
+#undef MAKE_Y4
+#undef PAIR_SUM
+#undef AVERAGE_2x2
+    return i;
+}
+#endif /* __SSE2__ */
+
+static void
+RGBtoPlanar2x2_Rows(void *data, int row_begin, int row_end)
+{
+    const RGBtoPlanar2x2Info *info = (const RGBtoPlanar2x2Info *)data;
+    const struct RGB2YUVFactors *cvt = info->cvt;
+    const int width = info->width;
+    const int bpp = info->bpp;
+    const int r_offset = info->r_offset;
+    const int g_offset = info->g_offset;
+    const int b_offset = info->b_offset;
+    int i, j;
+
+#define MAKE_Y(r, g, b) (Uint8)((int)(cvt->y[0] * (r) + cvt->y[1] * (g) + cvt->y[2] * (b) + 0.5f) + cvt->y_offset)
+#define MAKE_U(r, g, b) (Uint8)((int)(cvt->u[0] * (r) + cvt->u[1] * (g) + cvt->u[2] * (b) + 0.5f) + 128)
+#define MAKE_V(r, g, b) (Uint8)((int)(cvt->v[0] * (r) + cvt->v[1] * (g) + cvt->v[2] * (b) + 0.5f) + 128)
+#define ADD_PIXEL(row, x, plane_y) \
+    { \
+        const Uint8 *px = row + (x) * bpp; \
+        plane_y[x] = MAKE_Y(px[r_offset], px[g_offset], px[b_offset]); \
+        r += px[r_offset]; \
+        g += px[g_offset]; \
+        b += px[b_offset]; \
+        ++count; \
+    }
+
+    for (j = row_begin; j < row_end; j += 2) {
+        const Uint8 *row0 = info->src + j * info->src_pitch;
+        const Uint8 *row1 = (j + 1 < info->height) ? row0 + info->src_pitch : NULL;
+        Uint8 *y0 = info->plane_y + j * info->y_stride;
+        Uint8 *y1 = y0 + info->y_stride;
+        Uint8 *u = info->plane_u + (j / 2) * info->uv_stride;
+        Uint8 *v = info->plane_v + (j / 2) * info->uv_stride;
+
+        i = 0;
+#ifdef __SSE2__
+        if (info->use_SSE2 && bpp == 4 && row1) {
+            i = RGBtoPlanar2x2_SSE2(info, row0, row1, y0, y1, u, v);
+        }
+#endif
+        for (; i < width; i += 2) {
+            Uint32 r = 0, g = 0, b = 0;
+            int count = 0;
+
+            ADD_PIXEL(row0, i, y0);
+            if (i + 1 < width) {
+                ADD_PIXEL(row0, i + 1, y0);
+            }
+            if (row1) {
+                ADD_PIXEL(row1, i, y1);
+                if (i + 1 < width) {
+                    ADD_PIXEL(row1, i + 1, y1);
+                }
+            }
+            /* count is 1, 2 or 4 */
+            r >>= (count >> 1);
+            g >>= (count >> 1);
+            b >>= (count >> 1);
+            u[(i / 2) * info->uv_pixel_stride] = MAKE_U(r, g, b);
+            v[(i / 2) * info->uv_pixel_stride] = MAKE_V(r, g, b);
+        }
+    }
+#undef MAKE_Y
+#undef MAKE_U
+#undef MAKE_V
+#undef ADD_PIXEL
+}
+
+static int
+SDL_ConvertPixels_RGB_to_Planar2x2(int width, int height,
+         Uint32 src_format, const void *src, int src_pitch,
+         Uint32 dst_format, void *dst, int dst_pitch)
+{
+    RGBtoPlanar2x2Info info;
+
+    if (!GetRGBByteOffsets(src_format, &info.bpp, &info.r_offset, &info.g_offset, &info.b_offset)) {
+        return SDL_SetError("Unsupported RGB source format: %s", SDL_GetPixelFormatName(src_format));
+    }
+    if (GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
+                     (const Uint8 **)&info.plane_y, (const Uint8 **)&info.plane_u, (const Uint8 **)&info.plane_v,
+                     &info.y_stride, &info.uv_stride) < 0) {
+        return -1;
+    }
+
+    info.cvt = &RGB2YUVFactorTables[SDL_GetYUVConversionModeForResolution(width, height)];
+    info.width = width;
+    info.height = height;
+    info.src = (const Uint8 *)src;
+    info.src_pitch = src_pitch;
+    info.uv_pixel_stride = 1;
+    if (dst_format == SDL_PIXELFORMAT_NV12 || dst_format == SDL_PIXELFORMAT_NV21) {
+        /* GetYUVPlanes() points u and v at their bytes of the interleaved plane */
+        info.uv_pixel_stride = 2;
+    }
+    info.use_SSE2 = SDL_HasSSE2();
+
+    SDL_ParallelRows(height, 2, 64, RGBtoPlanar2x2_Rows, &info);
+    return 0;
+}
+
 int
 SDL_ConvertPixels_RGB_to_YUV(int width, int height,
          Uint32 src_format, const void *src, int src_pitch,
@@ -810,6 +1160,15 @@ SDL_ConvertPixels_RGB_to_YUV(int width, int height,
     }
 #endif
 
+    /* 24 and 32-bit RGB to 4:2:0, without an intermediate ARGB8888 copy */
+    if (IsPlanar2x2Format(dst_format)) {
+        int bpp, r_offset, g_offset, b_offset;
+
+        if (GetRGBByteOffsets(src_format, &bpp, &r_offset, &g_offset, &b_offset)) {
+            return SDL_ConvertPixels_RGB_to_Planar2x2(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch);
+        }
+    }
+
     /* ARGB8888 to FOURCC */
     if (src_format == SDL_PIXELFORMAT_ARGB8888) {
         return SDL_ConvertPixels_ARGB8888_to_YUV(width, height, src, src_pitch, dst_format, dst, dst_pitch);
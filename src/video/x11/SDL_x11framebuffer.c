@@ -22,9 +22,14 @@
 
 #if SDL_VIDEO_DRIVER_X11
 
+#include "SDL_hints.h"
+#include "SDL_log.h"
+#include "../../SDL_hints_c.h"
 #include "SDL_x11video.h"
 #include "SDL_x11framebuffer.h"
 
+/* The window data that points at a window's running total of bytes sent */
+#define X11_FRAMEBUFFER_BYTES_DATA  "SDL_X11_FRAMEBUFFER_BYTES"
 
 #ifndef NO_SHARED_MEMORY
 
@@ -56,10 +61,17 @@ X11_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * format,
     Display *display = data->videodata->display;
     XGCValues gcv;
     XVisualInfo vinfo;
+    const char *shm_hint = SDL_GetHint(SDL_HINT_VIDEO_X11_FRAMEBUFFER_SHM);
+    /* Unset means shared memory when it's there, otherwise it's a must or a never */
+    const SDL_bool use_shm = SDL_GetStringBoolean(shm_hint, SDL_TRUE);
+    const SDL_bool require_shm = (use_shm && shm_hint && *shm_hint) ? SDL_TRUE : SDL_FALSE;
 
     /* Free the old framebuffer surface */
     X11_DestroyWindowFramebuffer(_this, window);
 
+    /* The total lives with the window, so it carries on across resizes */
+    SDL_SetWindowData(window, X11_FRAMEBUFFER_BYTES_DATA, &data->framebuffer_bytes);
+
     /* Create the graphics context for drawing */
     gcv.graphics_exposures = False;
     data->gc = X11_XCreateGC(display, data->xwindow, GCGraphicsExposures, &gcv);
@@ -82,7 +94,7 @@ X11_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * format,
 
     /* Create the actual image */
 #ifndef NO_SHARED_MEMORY
-    if (have_mitshm(display)) {
+    if (use_shm && have_mitshm(display)) {
         XShmSegmentInfo *shminfo = &data->shminfo;
 
         shminfo->shmid = shmget(IPC_PRIVATE, window->h*(*pitch), IPC_CREAT | 0777);
@@ -117,12 +129,18 @@ X11_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * format,
                 /* Done! */
                 data->use_mitshm = SDL_TRUE;
                 *pixels = shminfo->shmaddr;
+                SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "X11 framebuffer: using MIT-SHM for a %dx%d window", window->w, window->h);
                 return 0;
             }
         }
     }
 #endif /* not NO_SHARED_MEMORY */
 
+    if (require_shm) {
+        return SDL_SetError("MIT-SHM is not available for the window framebuffer");
+    }
+    SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "X11 framebuffer: using XPutImage for a %dx%d window", window->w, window->h);
+
     *pixels = SDL_malloc(window->h*(*pitch));
     if (*pixels == NULL) {
         return SDL_OutOfMemory();
@@ -146,6 +164,7 @@ X11_UpdateWindowFramebuffer(_THIS, SDL_Window * window, const SDL_Rect * rects,
     Display *display = data->videodata->display;
     int i;
     int x, y, w ,h;
+    Uint64 bytes = 0;
 #ifndef NO_SHARED_MEMORY
     if (data->use_mitshm) {
         for (i = 0; i < numrects; ++i) {
@@ -175,6 +194,7 @@ X11_UpdateWindowFramebuffer(_THIS, SDL_Window * window, const SDL_Rect * rects,
 
             X11_XShmPutImage(display, data->xwindow, data->gc, data->ximage,
                 x, y, x, y, w, h, False);
+            bytes += (Uint64)w * h * (data->ximage->bits_per_pixel / 8);
         }
     }
     else
@@ -207,11 +227,16 @@ X11_UpdateWindowFramebuffer(_THIS, SDL_Window * window, const SDL_Rect * rects,
 
             X11_XPutImage(display, data->xwindow, data->gc, data->ximage,
                 x, y, x, y, w, h);
+            bytes += (Uint64)w * h * (data->ximage->bits_per_pixel / 8);
         }
     }
 
     X11_XSync(display, False);
 
+    data->framebuffer_bytes += bytes;
+    SDL_LogVerbose(SDL_LOG_CATEGORY_VIDEO, "X11 framebuffer: updated %d rects, %" SDL_PRIu64 " bytes (%" SDL_PRIu64 " total)",
+                   numrects, bytes, data->framebuffer_bytes);
+
     return 0;
 }
 
@@ -228,6 +253,8 @@ X11_DestroyWindowFramebuffer(_THIS, SDL_Window * window)
 
     display = data->videodata->display;
 
+    SDL_SetWindowData(window, X11_FRAMEBUFFER_BYTES_DATA, NULL);
+
     if (data->ximage) {
         XDestroyImage(data->ximage);
 
@@ -53,6 +53,7 @@ typedef struct
     XShmSegmentInfo shminfo;
 #endif
     XImage *ximage;
+    Uint64 framebuffer_bytes;   /* pixel data sent by X11_UpdateWindowFramebuffer() so far */
     GC gc;
     XIC ic;
     SDL_bool created;
@@ -7,8 +7,9 @@
 	YUV_FORMAT
 	RGB_FORMAT
 */
-/* You may define the following macro, which affects generated code:
+/* You may define the following macros, which affect generated code:
 	SSE_ALIGNED
+	SSE_AVX2	(do the arithmetic on 32 pixels at once with AVX2, the caller must check SDL_HasAVX2())
 */
 
 #ifdef SSE_ALIGNED
@@ -301,6 +302,103 @@ PACK_RGB24_32_STEP1(R1, R2, G1, G2, B1, B2, RGB1, RGB2, RGB3, RGB4, RGB5, RGB6)
 #error READ_UV unimplemented
 #endif
 
+#ifdef SSE_AVX2
+
+#define SSE_TARGET SDL_TARGETING("avx2")
+
+/* Same arithmetic as UV2RGB_16 and ADD_Y2RGB_16 on 32 pixels at once.
+   AVX2 unpacks within each 128-bit lane, so the duplicated chroma values
+   are put back in pixel order with a cross-lane permute. */
+#define UV2RGB_32(U,V,R1,G1,B1,R2,G2,B2) \
+{ \
+	__m256i r_tmp, g_tmp, b_tmp, lo, hi; \
+	r_tmp = _mm256_mullo_epi16(V, _mm256_set1_epi16(param->v_r_factor)); \
+	g_tmp = _mm256_add_epi16( \
+		_mm256_mullo_epi16(U, _mm256_set1_epi16(param->u_g_factor)), \
+		_mm256_mullo_epi16(V, _mm256_set1_epi16(param->v_g_factor))); \
+	b_tmp = _mm256_mullo_epi16(U, _mm256_set1_epi16(param->u_b_factor)); \
+	lo = _mm256_unpacklo_epi16(r_tmp, r_tmp); \
+	hi = _mm256_unpackhi_epi16(r_tmp, r_tmp); \
+	R1 = _mm256_permute2x128_si256(lo, hi, 0x20); \
+	R2 = _mm256_permute2x128_si256(lo, hi, 0x31); \
+	lo = _mm256_unpacklo_epi16(g_tmp, g_tmp); \
+	hi = _mm256_unpackhi_epi16(g_tmp, g_tmp); \
+	G1 = _mm256_permute2x128_si256(lo, hi, 0x20); \
+	G2 = _mm256_permute2x128_si256(lo, hi, 0x31); \
+	lo = _mm256_unpacklo_epi16(b_tmp, b_tmp); \
+	hi = _mm256_unpackhi_epi16(b_tmp, b_tmp); \
+	B1 = _mm256_permute2x128_si256(lo, hi, 0x20); \
+	B2 = _mm256_permute2x128_si256(lo, hi, 0x31); \
+}
+
+#define ADD_Y2RGB_32(Y1,Y2,R1,G1,B1,R2,G2,B2) \
+	Y1 = _mm256_mullo_epi16(_mm256_sub_epi16(Y1, _mm256_set1_epi16(param->y_shift)), _mm256_set1_epi16(param->y_factor)); \
+	Y2 = _mm256_mullo_epi16(_mm256_sub_epi16(Y2, _mm256_set1_epi16(param->y_shift)), _mm256_set1_epi16(param->y_factor)); \
+	\
+	R1 = _mm256_srai_epi16(_mm256_add_epi16(R1, Y1), PRECISION); \
+	G1 = _mm256_srai_epi16(_mm256_add_epi16(G1, Y1), PRECISION); \
+	B1 = _mm256_srai_epi16(_mm256_add_epi16(B1, Y1), PRECISION); \
+	R2 = _mm256_srai_epi16(_mm256_add_epi16(R2, Y2), PRECISION); \
+	G2 = _mm256_srai_epi16(_mm256_add_epi16(G2, Y2), PRECISION); \
+	B2 = _mm256_srai_epi16(_mm256_add_epi16(B2, Y2), PRECISION); \
+
+/* Saturate 32 pixels to bytes and split them into the two 16 pixel halves PACK_PIXEL expects */
+#define PACKUS_32(A, B, HALF1, HALF2) \
+{ \
+	__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(A, B), 0xD8); \
+	HALF1 = _mm256_castsi256_si128(packed); \
+	HALF2 = _mm256_extracti128_si256(packed, 1); \
+}
+
+#define YUV2RGB_32 \
+	__m256i r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2; \
+	__m256i r_uv_16_1, g_uv_16_1, b_uv_16_1, r_uv_16_2, g_uv_16_2, b_uv_16_2; \
+	__m256i y_16_1, y_16_2, u_16, v_16; \
+	__m128i y, u, v; \
+	__m128i r_8_11, g_8_11, b_8_11, r_8_21, g_8_21, b_8_21; \
+	__m128i r_8_12, g_8_12, b_8_12, r_8_22, g_8_22, b_8_22; \
+	\
+	READ_UV \
+	\
+	u_16 = _mm256_add_epi16(_mm256_cvtepu8_epi16(u), _mm256_set1_epi16(-128)); \
+	v_16 = _mm256_add_epi16(_mm256_cvtepu8_epi16(v), _mm256_set1_epi16(-128)); \
+	\
+	UV2RGB_32(u_16, v_16, r_uv_16_1, g_uv_16_1, b_uv_16_1, r_uv_16_2, g_uv_16_2, b_uv_16_2) \
+	\
+	/* process the 32 pixels of first line */\
+	r_16_1=r_uv_16_1; g_16_1=g_uv_16_1; b_16_1=b_uv_16_1; \
+	r_16_2=r_uv_16_2; g_16_2=g_uv_16_2; b_16_2=b_uv_16_2; \
+	\
+	READ_Y(y_ptr1) \
+	y_16_1 = _mm256_cvtepu8_epi16(y); \
+	READ_Y(y_ptr1+16*y_pixel_stride) \
+	y_16_2 = _mm256_cvtepu8_epi16(y); \
+	\
+	ADD_Y2RGB_32(y_16_1, y_16_2, r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2) \
+	\
+	PACKUS_32(r_16_1, r_16_2, r_8_11, r_8_12) \
+	PACKUS_32(g_16_1, g_16_2, g_8_11, g_8_12) \
+	PACKUS_32(b_16_1, b_16_2, b_8_11, b_8_12) \
+	\
+	/* process the 32 pixels of second line */\
+	r_16_1=r_uv_16_1; g_16_1=g_uv_16_1; b_16_1=b_uv_16_1; \
+	r_16_2=r_uv_16_2; g_16_2=g_uv_16_2; b_16_2=b_uv_16_2; \
+	\
+	READ_Y(y_ptr2) \
+	y_16_1 = _mm256_cvtepu8_epi16(y); \
+	READ_Y(y_ptr2+16*y_pixel_stride) \
+	y_16_2 = _mm256_cvtepu8_epi16(y); \
+	\
+	ADD_Y2RGB_32(y_16_1, y_16_2, r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2) \
+	\
+	PACKUS_32(r_16_1, r_16_2, r_8_21, r_8_22) \
+	PACKUS_32(g_16_1, g_16_2, g_8_21, g_8_22) \
+	PACKUS_32(b_16_1, b_16_2, b_8_21, b_8_22) \
+
+#else
+
+#define SSE_TARGET
+
 #define YUV2RGB_32 \
 	__m128i r_tmp, g_tmp, b_tmp; \
 	__m128i r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2; \
@@ -381,8 +479,9 @@ PACK_RGB24_32_STEP1(R1, R2, G1, G2, B1, B2, RGB1, RGB2, RGB3, RGB4, RGB5, RGB6)
 	b_8_22 = _mm_packus_epi16(b_16_1, b_16_2); \
 	\
 
+#endif /* SSE_AVX2 */
 
-void SSE_FUNCTION_NAME(uint32_t width, uint32_t height, 
+SSE_TARGET void SSE_FUNCTION_NAME(uint32_t width, uint32_t height, 
 	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride, 
 	uint8_t *RGB, uint32_t RGB_stride, 
 	YCbCrType yuv_type)
@@ -482,6 +581,8 @@ void SSE_FUNCTION_NAME(uint32_t width, uint32_t height,
 #undef YUV_FORMAT
 #undef RGB_FORMAT
 #undef SSE_ALIGNED
+#undef SSE_AVX2
+#undef SSE_TARGET
 #undef LOAD_SI128
 #undef SAVE_SI128
 #undef UV2RGB_16
@@ -496,3 +597,6 @@ void SSE_FUNCTION_NAME(uint32_t width, uint32_t height,
 #undef READ_Y
 #undef READ_UV
 #undef YUV2RGB_32
+#undef UV2RGB_32
+#undef ADD_Y2RGB_32
+#undef PACKUS_32
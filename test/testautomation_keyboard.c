@@ -648,6 +648,54 @@ keyboard_getScancodeFromNameNegative(void *arg)
    return TEST_COMPLETED;
 }
 
+/**
+ * @brief Check that SDL_GetInputSnapshot tracks SDL_SetModState and rejects invalid data
+ *
+ * @sa http://wiki.libsdl.org/SDL_GetInputSnapshot
+ */
+int
+keyboard_getInputSnapshot(void *arg)
+{
+   SDL_InputSnapshot snapshot;
+   SDL_Keymod currentState;
+   Uint32 version;
+   int result;
+   const char *error;
+
+   currentState = SDL_GetModState();
+   SDLTest_AssertPass("Call to SDL_GetModState()");
+
+   result = SDL_GetInputSnapshot(&snapshot);
+   SDLTest_AssertPass("Call to SDL_GetInputSnapshot()");
+   SDLTest_AssertCheck(result == 0, "Verify result from call, expected: 0, got: %i", result);
+   SDLTest_AssertCheck(snapshot.mod == currentState, "Verify snapshot modifiers, expected: %i, got: %i", currentState, snapshot.mod);
+   version = snapshot.version;
+
+   SDL_SetModState(KMOD_CAPS);
+   SDLTest_AssertPass("Call to SDL_SetModState(KMOD_CAPS)");
+   result = SDL_GetInputSnapshot(&snapshot);
+   SDLTest_AssertPass("Call to SDL_GetInputSnapshot()");
+   SDLTest_AssertCheck(result == 0, "Verify result from call, expected: 0, got: %i", result);
+   SDLTest_AssertCheck(snapshot.mod == KMOD_CAPS, "Verify snapshot modifiers, expected: %i, got: %i", KMOD_CAPS, snapshot.mod);
+   SDLTest_AssertCheck(snapshot.version != version, "Verify snapshot version changed, got: %u", snapshot.version);
+
+   SDL_SetModState(currentState);
+   SDLTest_AssertPass("Call to SDL_SetModState(%i)", currentState);
+
+   /* NULL input */
+   SDL_ClearError();
+   SDLTest_AssertPass("Call to SDL_ClearError()");
+   result = SDL_GetInputSnapshot(NULL);
+   SDLTest_AssertPass("Call to SDL_GetInputSnapshot(NULL)");
+   SDLTest_AssertCheck(result < 0, "Verify result from call, expected: <0, got: %i", result);
+   error = SDL_GetError();
+   SDLTest_AssertPass("Call to SDL_GetError()");
+   SDLTest_AssertCheck(error != NULL && *error != '\0', "Validate that an error was set");
+   SDL_ClearError();
+
+   return TEST_COMPLETED;
+}
+
 
 
 /* ================= Test References ================== */
@@ -695,11 +743,14 @@ static const SDLTest_TestCaseReference keyboardTest13 =
 static const SDLTest_TestCaseReference keyboardTest14 =
         { (SDLTest_TestCaseFp)keyboard_getScancodeNameNegative, "keyboard_getScancodeNameNegative", "Check call to SDL_GetScancodeName with invalid data", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference keyboardTest15 =
+        { (SDLTest_TestCaseFp)keyboard_getInputSnapshot, "keyboard_getInputSnapshot", "Check call to SDL_GetInputSnapshot with and without valid data", TEST_ENABLED };
+
 /* Sequence of Keyboard test cases */
 static const SDLTest_TestCaseReference *keyboardTests[] =  {
     &keyboardTest1, &keyboardTest2, &keyboardTest3, &keyboardTest4, &keyboardTest5, &keyboardTest6,
     &keyboardTest7, &keyboardTest8, &keyboardTest9, &keyboardTest10, &keyboardTest11, &keyboardTest12,
-    &keyboardTest13, &keyboardTest14, NULL
+    &keyboardTest13, &keyboardTest14, &keyboardTest15, NULL
 };
 
 /* Keyboard test suite (global) */
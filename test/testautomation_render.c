@@ -570,6 +570,293 @@ render_testBlitAlpha (void *arg)
    return TEST_COMPLETED;
 }
 
+/* Counts the allocations made while the software renderer draws, to tell
+   a rotation served from its cache from one that was done again */
+static int _allocationCount = 0;
+static SDL_malloc_func _realMalloc = NULL;
+static SDL_calloc_func _realCalloc = NULL;
+static SDL_realloc_func _realRealloc = NULL;
+static SDL_free_func _realFree = NULL;
+
+static void * SDLCALL
+_countingMalloc(size_t size)
+{
+   ++_allocationCount;
+   return _realMalloc(size);
+}
+
+static void * SDLCALL
+_countingCalloc(size_t nmemb, size_t size)
+{
+   ++_allocationCount;
+   return _realCalloc(nmemb, size);
+}
+
+static void * SDLCALL
+_countingRealloc(void *mem, size_t size)
+{
+   ++_allocationCount;
+   return _realRealloc(mem, size);
+}
+
+/**
+ * @brief Tests that rotated copies of a texture follow its updates and are reused otherwise with the software renderer.
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/SDL_RenderCopyEx
+ * http://wiki.libsdl.org/SDL_UpdateTexture
+ */
+int
+render_testCopyExUpdate(void *arg)
+{
+   int ret, i;
+   SDL_Surface *surface;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   SDL_Rect rect, readRect;
+   Uint32 pixels[8 * 8];
+   Uint32 pixel;
+   const Uint32 colors[] = { 0xFFFF0000, 0xFF00FF00, 0xFF0000FF };
+   int c, rotatedAllocations = 0, cachedAllocations;
+
+   surface = SDL_CreateRGBSurfaceWithFormat(0, 32, 32, 0, RENDER_COMPARE_FORMAT);
+   SDLTest_AssertCheck(surface != NULL, "Verify SDL_CreateRGBSurfaceWithFormat() result");
+   if (surface == NULL) {
+      return TEST_ABORTED;
+   }
+   swrenderer = SDL_CreateSoftwareRenderer(surface);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify SDL_CreateSoftwareRenderer() result");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(surface);
+      return TEST_ABORTED;
+   }
+
+   texture = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 8, 8);
+   SDLTest_AssertCheck(texture != NULL, "Verify SDL_CreateTexture() result");
+   if (texture == NULL) {
+      SDL_DestroyRenderer(swrenderer);
+      SDL_FreeSurface(surface);
+      return TEST_ABORTED;
+   }
+
+   rect.x = 8;
+   rect.y = 8;
+   rect.w = 16;
+   rect.h = 16;
+   readRect.x = 16;
+   readRect.y = 16;
+   readRect.w = 1;
+   readRect.h = 1;
+
+   SDL_GetMemoryFunctions(&_realMalloc, &_realCalloc, &_realRealloc, &_realFree);
+   SDL_SetMemoryFunctions(_countingMalloc, _countingCalloc, _countingRealloc, _realFree);
+
+   /* Draw the same rotation after each update, it must show the new pixels.
+      A general angle can't be redone in place like a quarter turn can. */
+   for (c = 0; c < SDL_arraysize(colors); ++c) {
+      for (i = 0; i < SDL_arraysize(pixels); ++i) {
+         pixels[i] = colors[c];
+      }
+      ret = SDL_UpdateTexture(texture, NULL, pixels, 8 * sizeof(Uint32));
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+      _allocationCount = 0;
+      ret = SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, 45.0, NULL, SDL_FLIP_NONE);
+      SDL_RenderFlush(swrenderer);
+      rotatedAllocations = _allocationCount;
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyEx, expected: 0, got: %i", ret);
+      ret = SDL_RenderReadPixels(swrenderer, &readRect, RENDER_COMPARE_FORMAT, &pixel, sizeof(pixel));
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+      SDLTest_AssertCheck(pixel == colors[c], "Validate rotated pixel, expected: 0x%08x, got: 0x%08x", colors[c], pixel);
+   }
+
+   /* Without an update the same rotation comes from the cache. Drawing it
+      still allocates a little, but not the rotated copy and its mask. */
+   _allocationCount = 0;
+   ret = SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, 45.0, NULL, SDL_FLIP_NONE);
+   SDL_RenderFlush(swrenderer);
+   cachedAllocations = _allocationCount;
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyEx, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(cachedAllocations < rotatedAllocations,
+                       "Validate rotation was cached, expected fewer than %i allocations, got: %i", rotatedAllocations, cachedAllocations);
+   ret = SDL_RenderReadPixels(swrenderer, &readRect, RENDER_COMPARE_FORMAT, &pixel, sizeof(pixel));
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderReadPixels, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(pixel == colors[c - 1], "Validate rotated pixel, expected: 0x%08x, got: 0x%08x", colors[c - 1], pixel);
+
+   SDL_SetMemoryFunctions(_realMalloc, _realCalloc, _realRealloc, _realFree);
+
+   /* Clean up. */
+   SDL_DestroyTexture(texture);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(surface);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests drawing a premultiplied color that is brighter than its alpha with the software renderer.
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/SDL_SetRenderDrawBlendMode
+ * http://wiki.libsdl.org/SDL_RenderFillRect
+ */
+int
+render_testBlendPremultiplied(void *arg)
+{
+   const struct {
+      Uint32 format;
+      Uint32 expected;
+   } formats[] = {
+      { SDL_PIXELFORMAT_ARGB8888, 0xFFFFFFFF },
+      { SDL_PIXELFORMAT_RGB888, 0x00FFFFFF },
+      { SDL_PIXELFORMAT_RGB565, 0xFFFF },
+   };
+   /* Wide enough for the vectorized fills, plus odd sizes for the leftovers */
+   const SDL_Rect rects[] = { { 0, 0, 16, 2 }, { 0, 2, 3, 1 }, { 0, 3, 13, 1 } };
+   int f, x, y, ret;
+
+   for (f = 0; f < SDL_arraysize(formats); ++f) {
+      SDL_Surface *surface;
+      SDL_Renderer *swrenderer;
+      Uint32 pixel, mismatches = 0;
+
+      surface = SDL_CreateRGBSurfaceWithFormat(0, 16, 6, 0, formats[f].format);
+      SDLTest_AssertCheck(surface != NULL, "Verify SDL_CreateRGBSurfaceWithFormat() result");
+      if (surface == NULL) {
+         return TEST_ABORTED;
+      }
+      swrenderer = SDL_CreateSoftwareRenderer(surface);
+      SDLTest_AssertCheck(swrenderer != NULL, "Verify SDL_CreateSoftwareRenderer() result");
+      if (swrenderer == NULL) {
+         SDL_FreeSurface(surface);
+         return TEST_ABORTED;
+      }
+
+      SDL_SetRenderDrawColor(swrenderer, 200, 200, 200, SDL_ALPHA_OPAQUE);
+      SDL_RenderClear(swrenderer);
+
+      /* Half transparent white has every channel larger than alpha */
+      ret = SDL_SetRenderDrawBlendMode(swrenderer, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetRenderDrawBlendMode, expected: 0, got: %i", ret);
+      SDL_SetRenderDrawColor(swrenderer, 255, 255, 255, 128);
+      SDL_RenderFillRects(swrenderer, rects, SDL_arraysize(rects));
+      SDL_RenderDrawLine(swrenderer, 0, 4, 15, 4);
+      SDL_RenderDrawPoint(swrenderer, 0, 5);
+      SDL_RenderPresent(swrenderer);
+
+      for (y = 0; y < surface->h; ++y) {
+         for (x = 0; x < surface->w; ++x) {
+            const Uint8 *p = (const Uint8 *)surface->pixels + y * surface->pitch + x * surface->format->BytesPerPixel;
+            const SDL_bool drawn = (y < 2 || (y == 2 && x < 3) || (y == 3 && x < 13) || y == 4 || (y == 5 && x == 0));
+            if (surface->format->BytesPerPixel == 2) {
+               pixel = *(const Uint16 *)p;
+            } else {
+               pixel = *(const Uint32 *)p;
+            }
+            if (drawn && pixel != formats[f].expected) {
+               if (mismatches++ == 0) {
+                  SDLTest_LogError("%s pixel at %d,%d: expected 0x%08x, got 0x%08x",
+                                   SDL_GetPixelFormatName(formats[f].format), x, y, formats[f].expected, pixel);
+               }
+            }
+         }
+      }
+      SDLTest_AssertCheck(mismatches == 0, "Verify %s premultiplied drawing saturates, %u pixels differ",
+                          SDL_GetPixelFormatName(formats[f].format), mismatches);
+
+      SDL_DestroyRenderer(swrenderer);
+      SDL_FreeSurface(surface);
+   }
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that quarter turns of an updated texture match ones of a new texture with the software renderer.
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/SDL_RenderCopyEx
+ * http://wiki.libsdl.org/SDL_UpdateTexture
+ */
+int
+render_testCopyExQuarterTurns(void *arg)
+{
+   const double angles[] = { 90.0, 180.0, 270.0, -90.0, 450.0 };
+   const SDL_RendererFlip flips[] = { SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL };
+   const SDL_Rect rect = { 4, 5, 6, 4 };
+   Uint32 before[6 * 4], after[6 * 4];
+   Uint32 updated[16 * 16], fresh[16 * 16], previous[16 * 16];
+   SDL_Surface *surface;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture, *reference;
+   int a, f, i, ret;
+
+   for (i = 0; i < SDL_arraysize(before); ++i) {
+      before[i] = 0xFF000000 | (i * 0x0A0B0C);
+      after[i] = 0xFF000000 | ((SDL_arraysize(after) - i) * 0x0C0B0A);
+   }
+
+   surface = SDL_CreateRGBSurfaceWithFormat(0, 16, 16, 0, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(surface != NULL, "Verify SDL_CreateRGBSurfaceWithFormat() result");
+   if (surface == NULL) {
+      return TEST_ABORTED;
+   }
+   swrenderer = SDL_CreateSoftwareRenderer(surface);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify SDL_CreateSoftwareRenderer() result");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(surface);
+      return TEST_ABORTED;
+   }
+   texture = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 6, 4);
+   reference = SDL_CreateTexture(swrenderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 6, 4);
+   SDLTest_AssertCheck(texture != NULL && reference != NULL, "Verify SDL_CreateTexture() results");
+   if (texture == NULL || reference == NULL) {
+      SDL_DestroyRenderer(swrenderer);
+      SDL_FreeSurface(surface);
+      return TEST_ABORTED;
+   }
+   /* The NONE blend mode also needs the rotated mask */
+   SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+   SDL_SetTextureBlendMode(reference, SDL_BLENDMODE_NONE);
+   SDL_UpdateTexture(reference, NULL, after, 6 * sizeof(Uint32));
+
+   for (a = 0; a < SDL_arraysize(angles); ++a) {
+      for (f = 0; f < SDL_arraysize(flips); ++f) {
+         /* Rotate the texture, then again after changing its pixels */
+         SDL_UpdateTexture(texture, NULL, before, 6 * sizeof(Uint32));
+         SDL_RenderClear(swrenderer);
+         SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, angles[a], NULL, flips[f]);
+         SDL_RenderReadPixels(swrenderer, NULL, SDL_PIXELFORMAT_ARGB8888, previous, 16 * sizeof(Uint32));
+
+         ret = SDL_UpdateTexture(texture, NULL, after, 6 * sizeof(Uint32));
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+         SDL_RenderClear(swrenderer);
+         ret = SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, angles[a], NULL, flips[f]);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyEx, expected: 0, got: %i", ret);
+         SDL_RenderReadPixels(swrenderer, NULL, SDL_PIXELFORMAT_ARGB8888, updated, 16 * sizeof(Uint32));
+
+         /* A texture that never had other pixels gets rotated from scratch */
+         SDL_RenderClear(swrenderer);
+         SDL_RenderCopyEx(swrenderer, reference, NULL, &rect, angles[a], NULL, flips[f]);
+         SDL_RenderReadPixels(swrenderer, NULL, SDL_PIXELFORMAT_ARGB8888, fresh, 16 * sizeof(Uint32));
+
+         SDLTest_AssertCheck(SDL_memcmp(previous, updated, sizeof(updated)) != 0,
+                             "Verify the update shows at %g degrees, flip %d", angles[a], (int)flips[f]);
+         SDLTest_AssertCheck(SDL_memcmp(updated, fresh, sizeof(updated)) == 0,
+                             "Verify the updated texture matches a new one at %g degrees, flip %d", angles[a], (int)flips[f]);
+      }
+   }
+
+   SDL_DestroyTexture(reference);
+   SDL_DestroyTexture(texture);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(surface);
+
+   return TEST_COMPLETED;
+}
+
 /* Helper functions */
 
 /**
@@ -1085,9 +1372,18 @@ static const SDLTest_TestCaseReference renderTest6 =
 static const SDLTest_TestCaseReference renderTest7 =
         {  (SDLTest_TestCaseFp)render_testBlitBlend, "render_testBlitBlend", "Tests blitting with blending", TEST_DISABLED };
 
+static const SDLTest_TestCaseReference renderTest8 =
+        { (SDLTest_TestCaseFp)render_testCopyExUpdate, "render_testCopyExUpdate", "Tests software rotated copies of an updated texture", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest9 =
+        { (SDLTest_TestCaseFp)render_testBlendPremultiplied, "render_testBlendPremultiplied", "Tests software premultiplied drawing with colors brighter than alpha", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderTest10 =
+        { (SDLTest_TestCaseFp)render_testCopyExQuarterTurns, "render_testCopyExQuarterTurns", "Tests software quarter turns of an updated texture", TEST_ENABLED };
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] =  {
-    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, NULL
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, &renderTest9, &renderTest10, NULL
 };
 
 /* Render test suite (global) */
@@ -334,6 +334,204 @@ rwops_testFileRead(void)
    return TEST_COMPLETED;
 }
 
+/**
+ * @brief Tests reading from a memory mapped file.
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_RWFromFileMapped
+ * http://wiki.libsdl.org/SDL_LoadFile_RW
+ */
+int
+rwops_testFileMapped(void)
+{
+   SDL_RWops *rw;
+   void *data;
+   size_t datasize = 0;
+   int result;
+
+   /* Read test. */
+   rw = SDL_RWFromFileMapped(RWopsReadTestFilename);
+   SDLTest_AssertPass("Call to SDL_RWFromFileMapped() succeeded");
+   SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_RWFromFileMapped does not return NULL");
+
+   /* Bail out if NULL */
+   if (rw == NULL) return TEST_ABORTED;
+
+   /* Check direct access to the mapping */
+   if (rw->type == SDL_RWOPS_MEMORY_RO) {
+      SDLTest_AssertCheck(
+         rw->hidden.mem.stop - rw->hidden.mem.base == (int)SDL_strlen(RWopsHelloWorldTestString),
+         "Verify mapped size; expected: %d, got: %d", (int)SDL_strlen(RWopsHelloWorldTestString), (int)(rw->hidden.mem.stop - rw->hidden.mem.base));
+      SDLTest_AssertCheck(
+         SDL_memcmp(rw->hidden.mem.base, RWopsHelloWorldTestString, SDL_strlen(RWopsHelloWorldTestString)) == 0,
+         "Verify mapped bytes match the file contents");
+   }
+
+   /* Run generic tests */
+   _testGenericRWopsValidations( rw, 0 );
+
+   /* Load the whole stream */
+   SDL_RWseek(rw, 0, RW_SEEK_SET);
+   data = SDL_LoadFile_RW(rw, &datasize, 1);
+   SDLTest_AssertPass("Call to SDL_LoadFile_RW() succeeded");
+   SDLTest_AssertCheck(data != NULL, "Verify SDL_LoadFile_RW() does not return NULL");
+   SDLTest_AssertCheck(datasize == SDL_strlen(RWopsHelloWorldTestString), "Verify loaded size; expected: %d, got: %d", (int)SDL_strlen(RWopsHelloWorldTestString), (int)datasize);
+   if (data) {
+      SDLTest_AssertCheck(SDL_strcmp((const char *)data, RWopsHelloWorldTestString) == 0, "Verify loaded data is null terminated and matches the file contents");
+      SDL_free(data);
+   }
+
+   /* Missing files still fail */
+   rw = SDL_RWFromFileMapped("a/bogus/path");
+   SDLTest_AssertCheck(rw == NULL, "Verify opening a missing file with SDL_RWFromFileMapped returns NULL");
+   if (rw) {
+      result = SDL_RWclose(rw);
+      SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+   }
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests reading and writing through a buffered stream.
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_RWFromBuffered
+ */
+int
+rwops_testBuffered(void)
+{
+   char mem[sizeof(RWopsHelloWorldTestString)];
+   SDL_RWops *rw;
+   Sint64 i;
+   Uint32 value;
+   int result;
+
+   /* Buffer smaller than the test string, so both paths are used */
+   SDL_zeroa(mem);
+   rw = SDL_RWFromBuffered(SDL_RWFromMem(mem, sizeof(RWopsHelloWorldTestString)-1), 5);
+   SDLTest_AssertPass("Call to SDL_RWFromBuffered() succeeded");
+   SDLTest_AssertCheck(rw != NULL, "Verify opening memory with SDL_RWFromBuffered does not return NULL");
+
+   /* Bail out if NULL */
+   if (rw == NULL) return TEST_ABORTED;
+
+   /* Run generic tests */
+   _testGenericRWopsValidations(rw, 1);
+
+   /* Relative seeks inside and outside of the read-ahead data */
+   i = SDL_RWseek(rw, 1, RW_SEEK_SET);
+   SDLTest_AssertCheck(i == 1, "Verify seek to 1 with SDL_RWseek (RW_SEEK_SET), expected 1, got %"SDL_PRIs64, i);
+   value = SDL_ReadLE16(rw);
+   SDLTest_AssertCheck(value == ('e' | ('l' << 8)), "Verify result from SDL_ReadLE16, expected 'el', got 0x%4.4x", (unsigned int)value);
+   i = SDL_RWseek(rw, -2, RW_SEEK_CUR);
+   SDLTest_AssertCheck(i == 1, "Verify seek back to 1 with SDL_RWseek (RW_SEEK_CUR), expected 1, got %"SDL_PRIs64, i);
+   i = SDL_RWseek(rw, 6, RW_SEEK_CUR);
+   SDLTest_AssertCheck(i == 7, "Verify seek to 7 with SDL_RWseek (RW_SEEK_CUR), expected 7, got %"SDL_PRIs64, i);
+   value = SDL_ReadBE32(rw);
+   SDLTest_AssertCheck(value == (('o' << 24) | ('r' << 16) | ('l' << 8) | 'd'), "Verify result from SDL_ReadBE32, expected 'orld', got 0x%8.8x", (unsigned int)value);
+
+   /* Buffered writes land in the inner stream after seeking */
+   i = SDL_RWseek(rw, 0, RW_SEEK_SET);
+   SDL_WriteU8(rw, 'J');
+   SDLTest_AssertCheck(mem[0] == 'H', "Verify write is buffered");
+   i = SDL_RWseek(rw, 0, RW_SEEK_CUR);
+   SDLTest_AssertCheck(i == 1, "Verify position after write, expected 1, got %"SDL_PRIs64, i);
+   SDLTest_AssertCheck(mem[0] == 'J', "Verify write is flushed by SDL_RWseek");
+
+   /* Close handle */
+   result = SDL_RWclose(rw);
+   SDLTest_AssertPass("Call to SDL_RWclose() succeeded");
+   SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+   /* Short writes to the inner stream are reported and not forgotten */
+   SDL_zeroa(mem);
+   rw = SDL_RWFromBuffered(SDL_RWFromMem(mem, 3), 8);
+   SDLTest_AssertCheck(rw != NULL, "Verify opening memory with SDL_RWFromBuffered does not return NULL");
+   if (rw == NULL) return TEST_ABORTED;
+   i = (Sint64)SDL_RWwrite(rw, RWopsHelloWorldTestString, 1, 5);
+   SDLTest_AssertCheck(i == 5, "Verify write is buffered, expected 5, got %"SDL_PRIs64, i);
+   i = SDL_RWseek(rw, 0, RW_SEEK_CUR);
+   SDLTest_AssertCheck(i == -1, "Verify SDL_RWseek fails after a short write, got %"SDL_PRIs64, i);
+   SDLTest_AssertCheck(SDL_memcmp(mem, RWopsHelloWorldTestString, 3) == 0, "Verify the bytes that fit were written");
+   i = SDL_RWseek(rw, 0, RW_SEEK_CUR);
+   SDLTest_AssertCheck(i == -1, "Verify SDL_RWseek still fails with unwritten data, got %"SDL_PRIs64, i);
+   result = SDL_RWclose(rw);
+   SDLTest_AssertCheck(result == -1, "Verify SDL_RWclose fails with unwritten data; got: %d", result);
+
+   /* NULL inner stream */
+   rw = SDL_RWFromBuffered(NULL, 0);
+   SDLTest_AssertCheck(rw == NULL, "Verify SDL_RWFromBuffered(NULL, 0) returns NULL");
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests reading in the background.
+ *
+ * \sa
+ * http://wiki.libsdl.org/SDL_RWreadAsync
+ * http://wiki.libsdl.org/SDL_WaitAsyncIOTask
+ */
+int
+rwops_testAsyncRead(void)
+{
+   char buf1[sizeof(RWopsHelloWorldTestString)];
+   char buf2[sizeof(RWopsAlphabetString)];
+   SDL_RWops *rw1, *rw2;
+   SDL_AsyncIOTask *task1, *task2, *task3;
+   Sint64 result;
+
+   SDL_zeroa(buf1);
+   SDL_zeroa(buf2);
+
+   rw1 = SDL_RWFromFile(RWopsReadTestFilename, "rb");
+   rw2 = SDL_RWFromFile(RWopsAlphabetFilename, "rb");
+   SDLTest_AssertCheck(rw1 != NULL && rw2 != NULL, "Verify opening files with SDL_RWFromFile does not return NULL");
+   if (rw1 == NULL || rw2 == NULL) {
+      if (rw1) SDL_RWclose(rw1);
+      if (rw2) SDL_RWclose(rw2);
+      return TEST_ABORTED;
+   }
+
+   /* Two sequential reads on one stream and one on another */
+   task1 = SDL_RWreadAsync(rw1, 0, buf1, 6);
+   task2 = SDL_RWreadAsync(rw1, -1, buf1 + 6, sizeof(buf1) - 6);
+   task3 = SDL_RWreadAsync(rw2, 10, buf2, 3);
+   SDLTest_AssertPass("Call to SDL_RWreadAsync() succeeded");
+   SDLTest_AssertCheck(task1 != NULL && task2 != NULL && task3 != NULL, "Verify SDL_RWreadAsync() does not return NULL");
+
+   result = SDL_WaitAsyncIOTask(task3);
+   SDLTest_AssertCheck(result == 3, "Verify result from SDL_WaitAsyncIOTask, expected 3, got %"SDL_PRIs64, result);
+   SDLTest_AssertCheck(SDL_memcmp(buf2, "KLM", 3) == 0, "Verify read bytes match expected string, expected 'KLM', got '%s'", buf2);
+
+   result = SDL_WaitAsyncIOTask(task1);
+   SDLTest_AssertCheck(result == 6, "Verify result from SDL_WaitAsyncIOTask, expected 6, got %"SDL_PRIs64, result);
+   result = SDL_WaitAsyncIOTask(task2);
+   SDLTest_AssertCheck(result == (Sint64)(sizeof(RWopsHelloWorldTestString)-7), "Verify short read at end of stream, expected %d, got %"SDL_PRIs64, (int)(sizeof(RWopsHelloWorldTestString)-7), result);
+   SDLTest_AssertCheck(SDL_strcmp(buf1, RWopsHelloWorldTestString) == 0, "Verify read bytes match expected string, expected '%s', got '%s'", RWopsHelloWorldTestString, buf1);
+
+   /* Polling a finished task */
+   task1 = SDL_RWreadAsync(rw2, 0, buf2, 1);
+   while (task1 && !SDL_AsyncIOTaskDone(task1)) {
+      SDL_Delay(1);
+   }
+   SDLTest_AssertPass("Call to SDL_AsyncIOTaskDone() succeeded");
+   result = SDL_WaitAsyncIOTask(task1);
+   SDLTest_AssertCheck(result == 1, "Verify result from SDL_WaitAsyncIOTask, expected 1, got %"SDL_PRIs64, result);
+
+   /* Invalid parameters */
+   task1 = SDL_RWreadAsync(NULL, 0, buf1, 1);
+   SDLTest_AssertCheck(task1 == NULL, "Verify SDL_RWreadAsync(NULL, ...) returns NULL");
+   result = SDL_WaitAsyncIOTask(NULL);
+   SDLTest_AssertCheck(result == -1, "Verify SDL_WaitAsyncIOTask(NULL) returns -1, got %"SDL_PRIs64, result);
+
+   SDL_RWclose(rw1);
+   SDL_RWclose(rw2);
+
+   return TEST_COMPLETED;
+}
+
 /**
  * @brief Tests writing from file.
  *
@@ -733,10 +931,20 @@ static const SDLTest_TestCaseReference rwopsTest9 =
 static const SDLTest_TestCaseReference rwopsTest10 =
         { (SDLTest_TestCaseFp)rwops_testCompareRWFromMemWithRWFromFile, "rwops_testCompareRWFromMemWithRWFromFile", "Compare RWFromMem and RWFromFile RWops for read and seek", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference rwopsTest11 =
+        { (SDLTest_TestCaseFp)rwops_testFileMapped, "rwops_testFileMapped", "Tests reading from a memory mapped file", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference rwopsTest12 =
+        { (SDLTest_TestCaseFp)rwops_testBuffered, "rwops_testBuffered", "Tests reading and writing through a buffered stream", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference rwopsTest13 =
+        { (SDLTest_TestCaseFp)rwops_testAsyncRead, "rwops_testAsyncRead", "Tests reading in the background", TEST_ENABLED };
+
 /* Sequence of RWops test cases */
 static const SDLTest_TestCaseReference *rwopsTests[] =  {
     &rwopsTest1, &rwopsTest2, &rwopsTest3, &rwopsTest4, &rwopsTest5, &rwopsTest6,
-    &rwopsTest7, &rwopsTest8, &rwopsTest9, &rwopsTest10, NULL
+    &rwopsTest7, &rwopsTest8, &rwopsTest9, &rwopsTest10, &rwopsTest11, &rwopsTest12,
+    &rwopsTest13, NULL
 };
 
 /* RWops test suite (global) */
@@ -589,6 +589,218 @@ surface_testBlitBlendLoop(void *arg) {
 
 }
 
+/**
+ * @brief Tests blitting with pre-multiplied alpha against the straight alpha formula.
+ */
+int
+surface_testBlitBlendPremultiplied(void *arg)
+{
+   const Uint32 dst_formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888 };
+   SDL_Surface *face, *premultiplied, *expected, *dst, *converted;
+   SDL_BlendMode blendMode;
+   Uint8 sR, sG, sB, sA, dR, dG, dB, dA;
+   Uint32 *src_pixel, *exp_pixel;
+   int i, x, y, ret;
+
+   face = SDLTest_ImageFace();
+   SDLTest_AssertCheck(face != NULL, "Verify face surface is not NULL");
+   if (face == NULL) {
+       return TEST_ABORTED;
+   }
+   premultiplied = SDL_ConvertSurfaceFormat(face, SDL_PIXELFORMAT_ARGB8888, 0);
+   expected = SDL_CreateRGBSurfaceWithFormat(0, face->w, face->h, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(premultiplied != NULL && expected != NULL, "Verify surfaces are not NULL");
+   if (premultiplied == NULL || expected == NULL) {
+       SDL_FreeSurface(face);
+       SDL_FreeSurface(premultiplied);
+       SDL_FreeSurface(expected);
+       return TEST_ABORTED;
+   }
+
+   /* Straight alpha blending of the face onto a half transparent background */
+   for (y = 0; y < face->h; ++y) {
+       src_pixel = (Uint32 *)((Uint8 *)premultiplied->pixels + y * premultiplied->pitch);
+       exp_pixel = (Uint32 *)((Uint8 *)expected->pixels + y * expected->pitch);
+       for (x = 0; x < face->w; ++x) {
+           SDL_GetRGBA(src_pixel[x], premultiplied->format, &sR, &sG, &sB, &sA);
+           dR = (Uint8)(x * 8);
+           dG = (Uint8)(y * 8);
+           dB = 200;
+           dA = 128;
+           dR = (Uint8)((sR * sA) / 255 + ((255 - sA) * dR) / 255);
+           dG = (Uint8)((sG * sA) / 255 + ((255 - sA) * dG) / 255);
+           dB = (Uint8)((sB * sA) / 255 + ((255 - sA) * dB) / 255);
+           dA = (Uint8)(sA + ((255 - sA) * dA) / 255);
+           exp_pixel[x] = SDL_MapRGBA(expected->format, dR, dG, dB, dA);
+       }
+   }
+
+   ret = SDL_PremultiplyAlpha(premultiplied->w, premultiplied->h,
+                              premultiplied->format->format, premultiplied->pixels, premultiplied->pitch,
+                              premultiplied->format->format, premultiplied->pixels, premultiplied->pitch);
+   SDLTest_AssertPass("Call to SDL_PremultiplyAlpha()");
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_PremultiplyAlpha(), expected: 0, got: %i", ret);
+   ret = SDL_SetSurfaceBlendMode(premultiplied, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+   SDLTest_AssertCheck(ret == 0, "Verify result from SDL_SetSurfaceBlendMode(), expected: 0, got: %i", ret);
+   ret = SDL_GetSurfaceBlendMode(premultiplied, &blendMode);
+   SDLTest_AssertCheck(ret == 0 && blendMode == SDL_BLENDMODE_BLEND_PREMULTIPLIED,
+                       "Verify SDL_GetSurfaceBlendMode(), expected: %i, got: %i", SDL_BLENDMODE_BLEND_PREMULTIPLIED, blendMode);
+
+   for (i = 0; i < SDL_arraysize(dst_formats); ++i) {
+       dst = SDL_CreateRGBSurfaceWithFormat(0, face->w, face->h, 32, dst_formats[i]);
+       SDLTest_AssertCheck(dst != NULL, "Verify destination surface is not NULL");
+       if (dst == NULL) {
+           continue;
+       }
+       for (y = 0; y < dst->h; ++y) {
+           for (x = 0; x < dst->w; ++x) {
+               *(Uint32 *)((Uint8 *)dst->pixels + y * dst->pitch + x * 4) = SDL_MapRGBA(dst->format, (Uint8)(x * 8), (Uint8)(y * 8), 200, 128);
+           }
+       }
+
+       ret = SDL_BlitSurface(premultiplied, NULL, dst, NULL);
+       SDLTest_AssertPass("Call to SDL_BlitSurface() to %s", SDL_GetPixelFormatName(dst_formats[i]));
+       SDLTest_AssertCheck(ret == 0, "Verify result from SDL_BlitSurface(), expected: 0, got: %i", ret);
+
+       converted = SDL_ConvertSurfaceFormat(dst, SDL_PIXELFORMAT_ARGB8888, 0);
+       SDLTest_AssertCheck(converted != NULL, "Verify converted surface is not NULL");
+       if (converted == NULL) {
+           SDL_FreeSurface(dst);
+           continue;
+       }
+       if (!dst->format->Amask) {
+           /* Only the color channels can be compared */
+           for (y = 0; y < converted->h; ++y) {
+               src_pixel = (Uint32 *)((Uint8 *)converted->pixels + y * converted->pitch);
+               exp_pixel = (Uint32 *)((Uint8 *)expected->pixels + y * expected->pitch);
+               for (x = 0; x < converted->w; ++x) {
+                   src_pixel[x] = (src_pixel[x] & ~converted->format->Amask) | (exp_pixel[x] & converted->format->Amask);
+               }
+           }
+       }
+       ret = SDLTest_CompareSurfaces(converted, expected, 0);
+       SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+       SDL_FreeSurface(converted);
+       SDL_FreeSurface(dst);
+   }
+
+   SDL_FreeSurface(expected);
+   SDL_FreeSurface(premultiplied);
+   SDL_FreeSurface(face);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that converting in bands of rows on several threads gives the same pixels.
+ */
+int
+surface_testParallelConversion(void *arg)
+{
+   const Uint32 formats[] = { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24 };
+   SDL_Surface *src, *serial, *parallel;
+   Uint32 *pixel;
+   int i, ret;
+
+   /* Big enough to be split, with an odd size */
+   src = SDL_CreateRGBSurfaceWithFormat(0, 1021, 777, 32, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(src != NULL, "Verify source surface is not NULL");
+   if (src == NULL) {
+       return TEST_ABORTED;
+   }
+   pixel = (Uint32 *)src->pixels;
+   for (i = 0; i < src->w * src->h; ++i) {
+       pixel[i] = (Uint32)i * 2654435761u;
+   }
+
+   for (i = 0; i < SDL_arraysize(formats); ++i) {
+       SDL_SetHint(SDL_HINT_PIXEL_CONVERSION_THREADS, "1");
+       serial = SDL_ConvertSurfaceFormat(src, formats[i], 0);
+       SDL_SetHint(SDL_HINT_PIXEL_CONVERSION_THREADS, "5");
+       parallel = SDL_ConvertSurfaceFormat(src, formats[i], 0);
+       SDLTest_AssertPass("Call to SDL_ConvertSurfaceFormat() to %s", SDL_GetPixelFormatName(formats[i]));
+       SDLTest_AssertCheck(serial != NULL && parallel != NULL, "Verify converted surfaces are not NULL");
+       if (serial != NULL && parallel != NULL) {
+           ret = SDL_memcmp(serial->pixels, parallel->pixels, (size_t)serial->pitch * serial->h);
+           SDLTest_AssertCheck(ret == 0, "Verify the threaded conversion matches, expected: 0, got: %i", ret);
+       }
+       SDL_FreeSurface(serial);
+       SDL_FreeSurface(parallel);
+   }
+   SDL_SetHint(SDL_HINT_PIXEL_CONVERSION_THREADS, NULL);
+   SDL_FreeSurface(src);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests SDL_ConvertPixels() between the common formats against blitting
+ */
+int
+surface_testConvertPixels(void *arg)
+{
+   const Uint32 formats[] = {
+       SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGBA8888,
+       SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB24,
+       SDL_PIXELFORMAT_RGB565
+   };
+   const int w = 37, h = 5;
+   Uint8 src[37 * 5 * 4], converted[37 * 5 * 4], blitted[37 * 5 * 4];
+   SDL_Surface *src_surface, *dst_surface;
+   SDL_Rect rect;
+   int i, j, k, ret, mismatch;
+
+   for (k = 0; k < sizeof(src); ++k) {
+       src[k] = (Uint8)(k * 167 + (k >> 3));
+   }
+   rect.x = 0;
+   rect.y = 0;
+   rect.w = w;
+   rect.h = h;
+
+   for (i = 0; i < SDL_arraysize(formats); ++i) {
+       for (j = 0; j < SDL_arraysize(formats); ++j) {
+           const int src_pitch = w * SDL_BYTESPERPIXEL(formats[i]);
+           const int dst_pitch = w * SDL_BYTESPERPIXEL(formats[j]);
+
+           SDL_memset(converted, 0, sizeof(converted));
+           SDL_memset(blitted, 0, sizeof(blitted));
+           ret = SDL_ConvertPixels(w, h, formats[i], src, src_pitch, formats[j], converted, dst_pitch);
+           SDLTest_AssertPass("Call to SDL_ConvertPixels() from %s to %s", SDL_GetPixelFormatName(formats[i]), SDL_GetPixelFormatName(formats[j]));
+           SDLTest_AssertCheck(ret == 0, "Verify result value; expected: 0, got: %i", ret);
+
+           src_surface = SDL_CreateRGBSurfaceWithFormatFrom(src, w, h, 0, src_pitch, formats[i]);
+           dst_surface = SDL_CreateRGBSurfaceWithFormatFrom(blitted, w, h, 0, dst_pitch, formats[j]);
+           SDLTest_AssertCheck(src_surface != NULL && dst_surface != NULL, "Verify surfaces are not NULL");
+           if (src_surface != NULL && dst_surface != NULL) {
+               SDL_SetSurfaceBlendMode(src_surface, SDL_BLENDMODE_NONE);
+               SDL_LowerBlit(src_surface, &rect, dst_surface, &rect);
+               mismatch = 0;
+               if (formats[j] == SDL_PIXELFORMAT_RGB888) {
+                   /* The padding byte isn't defined, only compare the colors */
+                   for (k = 0; k < w * h; ++k) {
+                       if ((((Uint32 *)converted)[k] ^ ((Uint32 *)blitted)[k]) & 0x00FFFFFF) {
+                           ++mismatch;
+                       }
+                   }
+               } else {
+                   for (k = 0; k < dst_pitch * h; ++k) {
+                       if (converted[k] != blitted[k]) {
+                           ++mismatch;
+                       }
+                   }
+               }
+               SDLTest_AssertCheck(mismatch == 0, "Verify converted pixels match blitted pixels, expected: 0, got: %i", mismatch);
+           }
+           SDL_FreeSurface(src_surface);
+           SDL_FreeSurface(dst_surface);
+       }
+   }
+
+   return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -631,11 +843,20 @@ static const SDLTest_TestCaseReference surfaceTest11 =
 static const SDLTest_TestCaseReference surfaceTest12 =
         { (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED};
 
+static const SDLTest_TestCaseReference surfaceTest13 =
+        { (SDLTest_TestCaseFp)surface_testBlitBlendPremultiplied, "surface_testBlitBlendPremultiplied", "Tests blitting routines with pre-multiplied blending mode.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest14 =
+        { (SDLTest_TestCaseFp)surface_testParallelConversion, "surface_testParallelConversion", "Tests surface conversion split across threads.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest15 =
+        { (SDLTest_TestCaseFp)surface_testConvertPixels, "surface_testConvertPixels", "Tests pixel conversion between the common formats.", TEST_ENABLED};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] =  {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTest13, &surfaceTest14, &surfaceTest15, NULL
 };
 
 /* Surface test suite (global) */
@@ -0,0 +1,328 @@
+/*
+  Copyright (C) 1997-2021 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark of the joystick and game controller event pipeline, using
+   virtual joysticks so that it runs on machines without any hardware.
+
+   One thread per virtual pad moves an axis and toggles a button at a fixed
+   rate, while the main thread pumps events like a game would. We report how
+   many events make it through, how long it takes from setting a value to
+   seeing the event come out of SDL_PollEvent(), and how much time is spent
+   in the event loop per event. Only loop iterations that return events count
+   towards the time per event, so spinning with --fps 0 doesn't skew it.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+/* Each axis value identifies the time it was set at, until it wraps around */
+#define NUM_STAMPS  4096
+#define STAMP_VALUE(stamp)  ((Sint16)((stamp) * 16 - 32768))
+#define VALUE_STAMP(value)  (((int)(value) + 32768) / 16)
+
+typedef struct
+{
+    SDL_Joystick *joystick;
+    SDL_GameController *controller;
+    SDL_Thread *thread;
+    int rate;
+    Uint32 sent;
+    Uint64 sent_at[NUM_STAMPS];
+} Pad;
+
+typedef struct
+{
+    Uint32 count;
+    Uint64 total;
+    Uint64 max;
+} Latency;
+
+static SDL_atomic_t done;
+static Uint64 frequency;
+
+/* Call this instead of exit(), so we can clean up SDL: atexit() is evil. */
+static void
+quit(int rc)
+{
+    SDL_Quit();
+    exit(rc);
+}
+
+static int SDLCALL
+DrivePad(void *data)
+{
+    Pad *pad = (Pad *)data;
+    const Uint64 interval = frequency / pad->rate;
+    Uint64 next = SDL_GetPerformanceCounter();
+
+    while (!SDL_AtomicGet(&done)) {
+        const int stamp = pad->sent % NUM_STAMPS;
+        Uint64 now;
+
+        /* The joystick lock taken when setting the value orders this store
+           before the main thread reads it back */
+        pad->sent_at[stamp] = SDL_GetPerformanceCounter();
+        SDL_JoystickSetVirtualAxis(pad->joystick, 0, STAMP_VALUE(stamp));
+        SDL_JoystickSetVirtualButton(pad->joystick, 0, (pad->sent & 1) ? SDL_PRESSED : SDL_RELEASED);
+        ++pad->sent;
+
+        /* Sleep while we're more than a millisecond early, then spin */
+        next += interval;
+        for (now = SDL_GetPerformanceCounter(); now < next; now = SDL_GetPerformanceCounter()) {
+            if ((next - now) * 1000 > frequency) {
+                SDL_Delay(1);
+            }
+        }
+    }
+    return 0;
+}
+
+static Pad *
+FindPad(Pad *pads, int num_pads, SDL_JoystickID instance_id)
+{
+    int i;
+
+    for (i = 0; i < num_pads; ++i) {
+        if (SDL_JoystickInstanceID(pads[i].joystick) == instance_id) {
+            return &pads[i];
+        }
+    }
+    return NULL;
+}
+
+static void
+AddLatency(Latency *latency, Pad *pad, Sint16 value, Uint64 now)
+{
+    const Uint64 sent_at = pad->sent_at[VALUE_STAMP(value) % NUM_STAMPS];
+
+    if (sent_at && now >= sent_at) {
+        const Uint64 elapsed = now - sent_at;
+        ++latency->count;
+        latency->total += elapsed;
+        latency->max = SDL_max(latency->max, elapsed);
+    }
+}
+
+static void
+PrintLatency(const char *what, const Latency *latency)
+{
+    if (latency->count == 0) {
+        SDL_Log("%-22s no events\n", what);
+        return;
+    }
+    SDL_Log("%-22s %u events, average %.3f ms, worst %.3f ms\n", what, latency->count,
+            (double)latency->total * 1000.0 / latency->count / frequency,
+            (double)latency->max * 1000.0 / frequency);
+}
+
+int
+main(int argc, char *argv[])
+{
+    int num_pads = 4;
+    int rate = 1000;
+    int fps = 60;
+    int seconds = 5;
+    SDL_bool use_controllers = SDL_TRUE;
+    Pad *pads;
+    Latency joy_latency, controller_latency;
+    Uint32 joy_events = 0, controller_events = 0, other_events = 0, total_sent = 0;
+    Uint64 start, end, now, next_frame, loop_time = 0, busy_time = 0;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "--pads") == 0 && argv[i + 1]) {
+            num_pads = SDL_atoi(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "--rate") == 0 && argv[i + 1]) {
+            rate = SDL_atoi(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "--fps") == 0 && argv[i + 1]) {
+            fps = SDL_atoi(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "--seconds") == 0 && argv[i + 1]) {
+            seconds = SDL_atoi(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "--joystick-only") == 0) {
+            use_controllers = SDL_FALSE;
+        } else {
+            SDL_Log("USAGE: %s [--pads N] [--rate HZ] [--fps N] [--seconds N] [--joystick-only]\n"
+                    "  --pads N         number of virtual pads (default 4)\n"
+                    "  --rate HZ        updates per second sent by each pad (default 1000)\n"
+                    "  --fps N          event loop iterations per second, 0 to spin (default 60)\n"
+                    "  --seconds N      how long to run (default 5)\n"
+                    "  --joystick-only  don't open the pads as game controllers\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (num_pads < 1 || rate < 1 || fps < 0 || seconds < 1) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Invalid arguments\n");
+        return 1;
+    }
+
+    /* There's no window, so make sure joystick events aren't filtered out */
+    SDL_SetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS, "1");
+
+    if (SDL_Init(SDL_INIT_GAMECONTROLLER) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+    frequency = SDL_GetPerformanceFrequency();
+
+    pads = (Pad *)SDL_calloc(num_pads, sizeof(*pads));
+    if (!pads) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        quit(1);
+    }
+
+    for (i = 0; i < num_pads; ++i) {
+        int device_index = SDL_JoystickAttachVirtual(SDL_JOYSTICK_TYPE_GAMECONTROLLER,
+                                                     SDL_CONTROLLER_AXIS_MAX,
+                                                     SDL_CONTROLLER_BUTTON_MAX, 0);
+        if (device_index < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't attach virtual joystick: %s\n", SDL_GetError());
+            quit(1);
+        }
+        if (use_controllers) {
+            pads[i].controller = SDL_GameControllerOpen(device_index);
+            pads[i].joystick = SDL_GameControllerGetJoystick(pads[i].controller);
+        } else {
+            pads[i].joystick = SDL_JoystickOpen(device_index);
+        }
+        if (!pads[i].joystick) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open virtual joystick: %s\n", SDL_GetError());
+            quit(1);
+        }
+        pads[i].rate = rate;
+    }
+
+    /* Get the attach events out of the way before we start measuring */
+    SDL_PumpEvents();
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+    SDL_Log("Driving %d %s at %d Hz for %d seconds, %s\n", num_pads,
+            use_controllers ? "game controllers" : "joysticks", rate, seconds,
+            fps ? "polling once per frame" : "polling continuously");
+
+    SDL_zero(joy_latency);
+    SDL_zero(controller_latency);
+    SDL_AtomicSet(&done, 0);
+    for (i = 0; i < num_pads; ++i) {
+        char name[32];
+
+        SDL_snprintf(name, sizeof(name), "VirtualPad%d", i);
+        pads[i].thread = SDL_CreateThread(DrivePad, name, &pads[i]);
+        if (!pads[i].thread) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create thread: %s\n", SDL_GetError());
+            SDL_AtomicSet(&done, 1);
+            while (i--) {
+                SDL_WaitThread(pads[i].thread, NULL);
+            }
+            quit(1);
+        }
+    }
+
+    start = SDL_GetPerformanceCounter();
+    end = start + seconds * frequency;
+    next_frame = start;
+    for (now = start; now < end; now = SDL_GetPerformanceCounter()) {
+        SDL_Event event;
+        Uint64 loop_start = now;
+        SDL_bool busy = SDL_FALSE;
+
+        while (SDL_PollEvent(&event)) {
+            Pad *pad;
+
+            busy = SDL_TRUE;
+
+            switch (event.type) {
+            case SDL_JOYAXISMOTION:
+                ++joy_events;
+                pad = FindPad(pads, num_pads, event.jaxis.which);
+                if (pad && event.jaxis.axis == 0) {
+                    AddLatency(&joy_latency, pad, event.jaxis.value, SDL_GetPerformanceCounter());
+                }
+                break;
+            case SDL_JOYBUTTONDOWN:
+            case SDL_JOYBUTTONUP:
+                ++joy_events;
+                break;
+            case SDL_CONTROLLERAXISMOTION:
+                ++controller_events;
+                pad = FindPad(pads, num_pads, event.caxis.which);
+                if (pad && event.caxis.axis == SDL_CONTROLLER_AXIS_LEFTX) {
+                    AddLatency(&controller_latency, pad, event.caxis.value, SDL_GetPerformanceCounter());
+                }
+                break;
+            case SDL_CONTROLLERBUTTONDOWN:
+            case SDL_CONTROLLERBUTTONUP:
+                ++controller_events;
+                break;
+            default:
+                ++other_events;
+                break;
+            }
+        }
+        now = SDL_GetPerformanceCounter();
+        loop_time += now - loop_start;
+        if (busy) {
+            busy_time += now - loop_start;
+        }
+
+        if (fps) {
+            next_frame += frequency / fps;
+            now = SDL_GetPerformanceCounter();
+            if (next_frame > now) {
+                SDL_Delay((Uint32)((next_frame - now) * 1000 / frequency));
+            }
+        }
+    }
+    now = SDL_GetPerformanceCounter();
+
+    SDL_AtomicSet(&done, 1);
+    for (i = 0; i < num_pads; ++i) {
+        SDL_WaitThread(pads[i].thread, NULL);
+        total_sent += pads[i].sent;
+    }
+
+    {
+        const double elapsed = (double)(now - start) / frequency;
+        const Uint32 total_events = joy_events + controller_events + other_events;
+
+        SDL_Log("%-22s %u (%.0f/s)\n", "Updates sent:", total_sent, total_sent / elapsed);
+        SDL_Log("%-22s %u (%.0f/s)\n", "Joystick events:", joy_events, joy_events / elapsed);
+        SDL_Log("%-22s %u (%.0f/s)\n", "Controller events:", controller_events, controller_events / elapsed);
+        SDL_Log("%-22s %u\n", "Other events:", other_events);
+        PrintLatency("Joystick latency:", &joy_latency);
+        if (use_controllers) {
+            PrintLatency("Controller latency:", &controller_latency);
+        }
+        SDL_Log("%-22s %.3f ms total, %.3f us per event\n", "Event loop time:",
+                (double)loop_time * 1000.0 / frequency,
+                total_events ? (double)busy_time * 1000000.0 / frequency / total_events : 0.0);
+    }
+
+    for (i = 0; i < num_pads; ++i) {
+        if (pads[i].controller) {
+            SDL_GameControllerClose(pads[i].controller);
+        } else {
+            SDL_JoystickClose(pads[i].joystick);
+        }
+    }
+    SDL_free(pads);
+
+    quit(0);
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
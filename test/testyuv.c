@@ -42,7 +42,7 @@ static SDL_Surface *generate_test_pattern(int pattern_size)
 
         /* R, G, B in alternating horizontal bands */
         for (y = 0; y < pattern->h; y += thickness) {
-            for (i = 0; i < thickness; ++i) {
+            for (i = 0; i < thickness && (y + i) < pattern->h; ++i) {
                 p = (Uint8 *)pattern->pixels + (y + i) * pattern->pitch + ((y/thickness) % 3);
                 for (x = 0; x < pattern->w; ++x) {
                     *p = 0xFF;
@@ -54,7 +54,7 @@ static SDL_Surface *generate_test_pattern(int pattern_size)
         /* Black and white in alternating vertical bands */
         c = 0xFF;
         for (x = 1*thickness; x < pattern->w; x += 2*thickness) {
-            for (i = 0; i < thickness; ++i) {
+            for (i = 0; i < thickness && (x + i) < pattern->w; ++i) {
                 p = (Uint8 *)pattern->pixels + (x + i)*3;
                 for (y = 0; y < pattern->h; ++y) {
                     SDL_memset(p, c, 3);
@@ -122,6 +122,14 @@ static int run_automated_tests(int pattern_size, int extra_pitch)
         SDL_PIXELFORMAT_UYVY,
         SDL_PIXELFORMAT_YVYU
     };
+    const Uint32 rgb_formats[] = {
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_PIXELFORMAT_ABGR8888,
+        SDL_PIXELFORMAT_RGBA8888,
+        SDL_PIXELFORMAT_BGRA8888,
+        SDL_PIXELFORMAT_RGB888,
+        SDL_PIXELFORMAT_BGR24
+    };
     int i, j;
     SDL_Surface *pattern = generate_test_pattern(pattern_size);
     const int yuv_len = MAX_YUV_SURFACE_SIZE(pattern->w, pattern->h, extra_pitch);
@@ -161,6 +169,31 @@ static int run_automated_tests(int pattern_size, int extra_pitch)
         }
     }
 
+    /* Verify conversion to YUV formats from other RGB formats gives the same result */
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        for (j = 0; j < SDL_arraysize(rgb_formats); ++j) {
+            SDL_Surface *rgb = SDL_ConvertSurfaceFormat(pattern, rgb_formats[j], 0);
+            if (!rgb) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't convert pattern to %s: %s\n", SDL_GetPixelFormatName(rgb_formats[j]), SDL_GetError());
+                goto done;
+            }
+            yuv1_pitch = CalculateYUVPitch(formats[i], pattern->w) + extra_pitch;
+            SDL_memset(yuv1, 0, yuv_len);
+            SDL_memset(yuv2, 0, yuv_len);
+            if (SDL_ConvertPixels(pattern->w, pattern->h, pattern->format->format, pattern->pixels, pattern->pitch, formats[i], yuv1, yuv1_pitch) < 0 ||
+                SDL_ConvertPixels(rgb->w, rgb->h, rgb->format->format, rgb->pixels, rgb->pitch, formats[i], yuv2, yuv1_pitch) < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't convert %s to %s: %s\n", SDL_GetPixelFormatName(rgb_formats[j]), SDL_GetPixelFormatName(formats[i]), SDL_GetError());
+                SDL_FreeSurface(rgb);
+                goto done;
+            }
+            SDL_FreeSurface(rgb);
+            if (SDL_memcmp(yuv1, yuv2, yuv_len) != 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Conversion from %s to %s doesn't match %s\n", SDL_GetPixelFormatName(rgb_formats[j]), SDL_GetPixelFormatName(formats[i]), SDL_GetPixelFormatName(pattern->format->format));
+                goto done;
+            }
+        }
+    }
+
     /* Verify conversion between YUV formats */
     for (i = 0; i < SDL_arraysize(formats); ++i) {
         for (j = 0; j < SDL_arraysize(formats); ++j) {